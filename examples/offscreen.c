@@ -36,10 +36,16 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+
+#include <tinycthread.h>
+#include <getopt.h>
 
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
 
+#define MAX_WORKERS 16
+
 static const struct
 {
     float x, y;
@@ -51,6 +57,29 @@ static const struct
     {   0.f,  0.6f, 0.f, 0.f, 1.f }
 };
 
+// Shaders for the OpenGL 3.2 core profile context used with readback buffers
+static const char* core_vertex_shader_text =
+"#version 150\n"
+"uniform mat4 MVP;\n"
+"in vec3 vCol;\n"
+"in vec2 vPos;\n"
+"out vec3 color;\n"
+"void main()\n"
+"{\n"
+"    gl_Position = MVP * vec4(vPos, 0.0, 1.0);\n"
+"    color = vCol;\n"
+"}\n";
+
+static const char* core_fragment_shader_text =
+"#version 150\n"
+"in vec3 color;\n"
+"out vec4 fragment;\n"
+"void main()\n"
+"{\n"
+"    fragment = vec4(color, 1.0);\n"
+"}\n";
+
+// Shaders for the OpenGL 2.0 context used when reading frames synchronously
 static const char* vertex_shader_text =
 "#version 110\n"
 "uniform mat4 MVP;\n"
@@ -71,20 +100,238 @@ static const char* fragment_shader_text =
 "    gl_FragColor = vec4(color, 1.0);\n"
 "}\n";
 
+// A captured frame waiting to be, or being, written to disk
+typedef struct
+{
+    unsigned char* pixels;
+    size_t size;
+    int width, height;
+    int number;
+} Image;
+
+// The capture ring shared by the render thread and the encoding workers
+//
+// Images move from the free stack to the queue when the render thread has
+// copied a frame into them, and back to the free stack once a worker has
+// written them.  The render thread never waits for a worker unless asked to.
+static struct
+{
+    mtx_t lock;
+    cnd_t queued_cond;   // An image was queued or capture has ended
+    cnd_t freed_cond;    // An image was returned to the free stack
+    Image* images;
+    int depth;
+    int* free_images;
+    int free_count;
+    int* queue;
+    int queue_head, queue_count;
+    int done;
+    int raw;
+    int single;
+} capture;
+
+static void usage(void)
+{
+    printf("Usage: offscreen [-e] [-n FRAMES] [-s WIDTHxHEIGHT] [-q DEPTH] [-j WORKERS] [-r] [-w]\n");
+    printf("       offscreen -h\n");
+    printf("Options:\n");
+    printf("  -e create the context with EGL\n");
+    printf("  -n render and capture this many frames (default 1)\n");
+    printf("  -s size of the framebuffer (default 640x480)\n");
+    printf("  -q number of captured frames that can wait for a worker (default 8)\n");
+    printf("  -j number of worker threads writing images (default 2)\n");
+    printf("  -r write raw RGBA files instead of PNG\n");
+    printf("  -w wait for a free image instead of dropping frames\n");
+}
+
 static void error_callback(int error, const char* description)
 {
     fprintf(stderr, "Error: %s\n", description);
 }
 
-int main(void)
+// Takes a free image sized for the frame, or returns NULL if there is none
+// and waiting was not requested
+static Image* acquire_image(int width, int height, int wait)
+{
+    Image* image;
+    const size_t size = (size_t) width * height * 4;
+
+    mtx_lock(&capture.lock);
+
+    while (!capture.free_count)
+    {
+        if (!wait)
+        {
+            mtx_unlock(&capture.lock);
+            return NULL;
+        }
+
+        cnd_wait(&capture.freed_cond, &capture.lock);
+    }
+
+    image = capture.images + capture.free_images[--capture.free_count];
+
+    mtx_unlock(&capture.lock);
+
+    if (image->size < size)
+    {
+        free(image->pixels);
+        image->pixels = malloc(size);
+        image->size = size;
+    }
+
+    image->width = width;
+    image->height = height;
+    return image;
+}
+
+// Hands a filled image to the workers
+static void queue_image(Image* image)
+{
+    mtx_lock(&capture.lock);
+    capture.queue[(capture.queue_head + capture.queue_count) % capture.depth] =
+        (int) (image - capture.images);
+    capture.queue_count++;
+    mtx_unlock(&capture.lock);
+
+    // NOTE: Mixing signals and broadcasts on this condition can leave a worker
+    //       waiting after the final broadcast with some versions of glibc
+    cnd_broadcast(&capture.queued_cond);
+}
+
+static void write_image(const Image* image)
+{
+    char path[64];
+    const int stride = image->width * 4;
+
+    if (capture.raw)
+    {
+        FILE* file;
+
+        if (capture.single)
+            snprintf(path, sizeof(path), "offscreen.raw");
+        else
+            snprintf(path, sizeof(path), "offscreen-%05i.raw", image->number);
+
+        file = fopen(path, "wb");
+        if (!file)
+        {
+            fprintf(stderr, "Failed to open %s\n", path);
+            return;
+        }
+
+        fwrite(image->pixels, stride, image->height, file);
+        fclose(file);
+    }
+    else
+    {
+        if (capture.single)
+            snprintf(path, sizeof(path), "offscreen.png");
+        else
+            snprintf(path, sizeof(path), "offscreen-%05i.png", image->number);
+
+        // Write image Y-flipped because OpenGL
+        stbi_write_png(path,
+                       image->width, image->height, 4,
+                       image->pixels + stride * (image->height - 1),
+                       -stride);
+    }
+}
+
+static int worker_main(void* data)
 {
-    GLFWwindow* window;
-    GLuint vertex_buffer, vertex_shader, fragment_shader, program;
+    for (;;)
+    {
+        int index;
+
+        mtx_lock(&capture.lock);
+
+        while (!capture.queue_count && !capture.done)
+            cnd_wait(&capture.queued_cond, &capture.lock);
+
+        if (!capture.queue_count)
+        {
+            mtx_unlock(&capture.lock);
+            break;
+        }
+
+        index = capture.queue[capture.queue_head];
+        capture.queue_head = (capture.queue_head + 1) % capture.depth;
+        capture.queue_count--;
+
+        mtx_unlock(&capture.lock);
+
+        write_image(capture.images + index);
+
+        mtx_lock(&capture.lock);
+        capture.free_images[capture.free_count++] = index;
+        mtx_unlock(&capture.lock);
+
+        cnd_signal(&capture.freed_cond);
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    GLFWwindow* window = NULL;
+    GLuint vertex_array, vertex_buffer, vertex_shader, fragment_shader, program;
     GLint mvp_location, vpos_location, vcol_location;
     float ratio;
-    int width, height;
-    mat4x4 mvp;
-    char* buffer;
+    int ch, i, width = 640, height = 480;
+    int frames = 1, depth = 8, worker_count = 2, wait = GLFW_FALSE;
+    int api = GLFW_NATIVE_CONTEXT_API;
+    int readback = GLFW_TRUE, captured = 0, dropped = 0;
+    uint64_t last_frame = 0;
+    double start, elapsed;
+    thrd_t workers[MAX_WORKERS];
+    GLFWframebufferdesc desc;
+
+    while ((ch = getopt(argc, argv, "ehj:n:q:rs:w")) != -1)
+    {
+        switch (ch)
+        {
+            case 'e':
+                api = GLFW_EGL_CONTEXT_API;
+                break;
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+            case 'j':
+                worker_count = atoi(optarg);
+                break;
+            case 'n':
+                frames = atoi(optarg);
+                break;
+            case 'q':
+                depth = atoi(optarg);
+                break;
+            case 'r':
+                capture.raw = GLFW_TRUE;
+                break;
+            case 's':
+                if (sscanf(optarg, "%ix%i", &width, &height) != 2)
+                {
+                    usage();
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'w':
+                wait = GLFW_TRUE;
+                break;
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (frames < 1 || width < 1 || height < 1 || depth < 1 ||
+        worker_count < 1 || worker_count > MAX_WORKERS)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
 
     glfwSetErrorCallback(error_callback);
 
@@ -93,15 +340,42 @@ int main(void)
     if (!glfwInit())
         exit(EXIT_FAILURE);
 
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, api);
     glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
-    window = glfwCreateWindow(640, 480, "Simple example", NULL, NULL);
+#if USE_NATIVE_OSMESA
+    // The OSMesa color buffer is already in client memory
+    readback = GLFW_FALSE;
+#endif
+
+    if (readback)
+    {
+        // Let the GPU copy frames in the background, which needs OpenGL 3.2
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
+        glfwWindowHint(GLFW_READBACK_BUFFERS, 3);
+
+        window = glfwCreateWindow(width, height, "Offscreen example", NULL, NULL);
+    }
+
     if (!window)
     {
-        glfwTerminate();
-        exit(EXIT_FAILURE);
+        // Fall back to an OpenGL 2.0 context and read each frame synchronously
+        readback = GLFW_FALSE;
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_ANY_PROFILE);
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_FALSE);
+        glfwWindowHint(GLFW_READBACK_BUFFERS, 0);
+
+        window = glfwCreateWindow(width, height, "Offscreen example", NULL, NULL);
+        if (!window)
+        {
+            glfwTerminate();
+            exit(EXIT_FAILURE);
+        }
     }
 
     glfwMakeContextCurrent(window);
@@ -114,11 +388,15 @@ int main(void)
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
     vertex_shader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex_shader, 1, &vertex_shader_text, NULL);
+    glShaderSource(vertex_shader, 1,
+                   readback ? &core_vertex_shader_text : &vertex_shader_text,
+                   NULL);
     glCompileShader(vertex_shader);
 
     fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment_shader, 1, &fragment_shader_text, NULL);
+    glShaderSource(fragment_shader, 1,
+                   readback ? &core_fragment_shader_text : &fragment_shader_text,
+                   NULL);
     glCompileShader(fragment_shader);
 
     program = glCreateProgram();
@@ -130,6 +408,13 @@ int main(void)
     vpos_location = glGetAttribLocation(program, "vPos");
     vcol_location = glGetAttribLocation(program, "vCol");
 
+    // The core profile has no default vertex array object
+    if (readback)
+    {
+        glGenVertexArrays(1, &vertex_array);
+        glBindVertexArray(vertex_array);
+    }
+
     glEnableVertexAttribArray(vpos_location);
     glVertexAttribPointer(vpos_location, 2, GL_FLOAT, GL_FALSE,
                           sizeof(vertices[0]), (void*) 0);
@@ -141,37 +426,142 @@ int main(void)
     ratio = width / (float) height;
 
     glViewport(0, 0, width, height);
-    glClear(GL_COLOR_BUFFER_BIT);
+    glUseProgram(program);
 
-    mat4x4_ortho(mvp, -ratio, ratio, -1.f, 1.f, 1.f, -1.f);
+    capture.depth = depth;
+    capture.single = (frames == 1);
+    capture.images = calloc(depth, sizeof(Image));
+    capture.free_images = calloc(depth, sizeof(int));
+    capture.queue = calloc(depth, sizeof(int));
 
-    glUseProgram(program);
-    glUniformMatrix4fv(mvp_location, 1, GL_FALSE, (const GLfloat*) mvp);
-    glDrawArrays(GL_TRIANGLES, 0, 3);
-    glFinish();
+    for (i = 0;  i < depth;  i++)
+        capture.free_images[capture.free_count++] = i;
 
-#if USE_NATIVE_OSMESA
-    glfwGetOSMesaColorBuffer(window, &width, &height, NULL, (void**) &buffer);
-#else
-    buffer = calloc(4, width * height);
-    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, buffer);
-#endif
+    mtx_init(&capture.lock, mtx_plain);
+    cnd_init(&capture.queued_cond);
+    cnd_init(&capture.freed_cond);
+
+    for (i = 0;  i < worker_count;  i++)
+    {
+        if (thrd_create(workers + i, worker_main, NULL) != thrd_success)
+        {
+            fprintf(stderr, "Failed to create worker thread\n");
+            glfwTerminate();
+            exit(EXIT_FAILURE);
+        }
+    }
 
-    // Write image Y-flipped because OpenGL
-    stbi_write_png("offscreen.png",
-                   width, height, 4,
-                   buffer + (width * 4 * (height - 1)),
-                   -width * 4);
+    start = glfwGetTime();
 
+    for (i = 0;  i < frames;  i++)
+    {
+        mat4x4 m, p, mvp;
+
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        mat4x4_identity(m);
+        mat4x4_rotate_Z(m, m, i * 0.01f);
+        mat4x4_ortho(p, -ratio, ratio, -1.f, 1.f, 1.f, -1.f);
+        mat4x4_mul(mvp, p, m);
+
+        glUniformMatrix4fv(mvp_location, 1, GL_FALSE, (const GLfloat*) mvp);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+
+        if (!readback)
+        {
+            Image* image = acquire_image(width, height, wait);
+            if (image)
+            {
 #if USE_NATIVE_OSMESA
-    // Here is where there's nothing
+                unsigned char* buffer;
+
+                glFinish();
+                glfwGetOSMesaColorBuffer(window, NULL, NULL, NULL, (void**) &buffer);
+                memcpy(image->pixels, buffer, (size_t) width * height * 4);
 #else
-    free(buffer);
+                glReadPixels(0, 0, width, height,
+                             GL_RGBA, GL_UNSIGNED_BYTE, image->pixels);
 #endif
+                image->number = i;
+                queue_image(image);
+                captured++;
+            }
+            else
+                dropped++;
+        }
+
+        glfwSwapBuffers(window);
+
+        if (readback)
+        {
+            // The last frame is collected after the loop, when it is certain
+            // to have completed
+            if (i == frames - 1)
+                glFinish();
+
+            if (glfwMapFramebuffer(window, &desc) && desc.frame != last_frame)
+            {
+                Image* image;
+
+                // Frames overwritten in the readback ring before completing
+                dropped += (int) (desc.frame - last_frame - 1);
+                last_frame = desc.frame;
+
+                image = acquire_image(desc.width, desc.height, wait);
+                if (image)
+                {
+                    int y;
+
+                    for (y = 0;  y < desc.height;  y++)
+                    {
+                        memcpy(image->pixels + y * desc.width * 4,
+                               desc.pixels + y * desc.stride,
+                               desc.width * 4);
+                    }
+
+                    image->number = (int) desc.frame - 1;
+                    queue_image(image);
+                    captured++;
+                }
+                else
+                    dropped++;
+            }
+        }
+    }
+
+    glfwUnmapFramebuffer(window);
+
+    mtx_lock(&capture.lock);
+    capture.done = GLFW_TRUE;
+    mtx_unlock(&capture.lock);
+    cnd_broadcast(&capture.queued_cond);
+
+    for (i = 0;  i < worker_count;  i++)
+        thrd_join(workers[i], NULL);
+
+    elapsed = glfwGetTime() - start;
+
+    if (frames > 1)
+    {
+        printf("Wrote %i of %i frames at %ix%i in %0.3f s (%0.1f frames/s)\n",
+               captured, frames, width, height, elapsed, captured / elapsed);
+        if (dropped)
+            printf("Dropped %i frames while all images were busy\n", dropped);
+    }
+
+    for (i = 0;  i < depth;  i++)
+        free(capture.images[i].pixels);
+
+    free(capture.images);
+    free(capture.free_images);
+    free(capture.queue);
+
+    cnd_destroy(&capture.freed_cond);
+    cnd_destroy(&capture.queued_cond);
+    mtx_destroy(&capture.lock);
 
     glfwDestroyWindow(window);
 
     glfwTerminate();
     exit(EXIT_SUCCESS);
 }
-
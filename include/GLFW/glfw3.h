@@ -317,6 +317,31 @@ extern "C" {
 #define GLFW_REPEAT                 2
 /*! @} */
 
+/*! @name Trace event types
+ *  @{ */
+/*! @brief The traced operation began.
+ *
+ *  The traced operation began.
+ *
+ *  @ingroup init
+ */
+#define GLFW_TRACE_BEGIN            1
+/*! @brief The traced operation ended.
+ *
+ *  The traced operation ended.
+ *
+ *  @ingroup init
+ */
+#define GLFW_TRACE_END              2
+/*! @brief Something happened at a single point in time.
+ *
+ *  Something happened at a single point in time.
+ *
+ *  @ingroup init
+ */
+#define GLFW_TRACE_INSTANT          3
+/*! @} */
+
 /*! @defgroup hat_state Joystick hat states
  *  @brief Joystick hat states.
  *
@@ -994,6 +1019,16 @@ extern "C" {
  *  [window hint](@ref GLFW_SCALE_TO_MONITOR).
  */
 #define GLFW_SCALE_TO_MONITOR       0x0002200C
+/*! @brief Framebuffer readback ring size hint.
+ *
+ *  Framebuffer readback ring size [hint](@ref GLFW_READBACK_BUFFERS_hint).
+ */
+#define GLFW_READBACK_BUFFERS       0x0002200D
+/*! @brief Late swap tearing support window attribute.
+ *
+ *  Late swap tearing support [attribute](@ref GLFW_CONTEXT_SWAP_TEAR_attrib).
+ */
+#define GLFW_CONTEXT_SWAP_TEAR      0x0002200E
 /*! @brief macOS specific
  *  [window hint](@ref GLFW_COCOA_RETINA_FRAMEBUFFER_hint).
  */
@@ -1163,6 +1198,11 @@ extern "C" {
  *  Joystick hat buttons [init hint](@ref GLFW_JOYSTICK_HAT_BUTTONS).
  */
 #define GLFW_JOYSTICK_HAT_BUTTONS   0x00050001
+/*! @brief Vulkan loader prefetch init hint.
+ *
+ *  Vulkan loader prefetch [init hint](@ref GLFW_VULKAN_LOADER_PREFETCH_hint).
+ */
+#define GLFW_VULKAN_LOADER_PREFETCH 0x00050002
 /*! @brief macOS specific init hint.
  *
  *  macOS specific [init hint](@ref GLFW_COCOA_CHDIR_RESOURCES_hint).
@@ -1246,6 +1286,18 @@ typedef struct GLFWwindow GLFWwindow;
  */
 typedef struct GLFWcursor GLFWcursor;
 
+/*! @brief Opaque shared context pool object.
+ *
+ *  Opaque shared context pool object.
+ *
+ *  @see @ref context_pool
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup context
+ */
+typedef struct GLFWcontextpool GLFWcontextpool;
+
 /*! @brief The function pointer type for error callbacks.
  *
  *  This is the function pointer type for error callbacks.  An error callback
@@ -1270,6 +1322,32 @@ typedef struct GLFWcursor GLFWcursor;
  */
 typedef void (* GLFWerrorfun)(int,const char*);
 
+/*! @brief The function pointer type for trace callbacks.
+ *
+ *  This is the function pointer type for trace callbacks.  A trace callback
+ *  function has the following signature:
+ *  @code
+ *  void callback_name(int type, const char* name, uint64_t time)
+ *  @endcode
+ *
+ *  @param[in] type One of `GLFW_TRACE_BEGIN`, `GLFW_TRACE_END` or
+ *  `GLFW_TRACE_INSTANT`.
+ *  @param[in] name The name of the traced operation.
+ *  @param[in] time The time of the event, in the units of @ref
+ *  glfwGetTimerValue.
+ *
+ *  @pointer_lifetime The name string is static and remains valid until the
+ *  library is unloaded.
+ *
+ *  @sa @ref intro_tracing
+ *  @sa @ref glfwSetTraceCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup init
+ */
+typedef void (* GLFWtracefun)(int,const char*,uint64_t);
+
 /*! @brief The function pointer type for window position callbacks.
  *
  *  This is the function pointer type for window position callbacks.  A window
@@ -1649,6 +1727,48 @@ typedef void (* GLFWcharmodsfun)(GLFWwindow*,unsigned int,int);
  */
 typedef void (* GLFWdropfun)(GLFWwindow*,int,const char*[]);
 
+/*! @brief The function pointer type for clipboard string callbacks.
+ *
+ *  This is the function pointer type for clipboard string callbacks.
+ *  A clipboard string callback function has the following signature:
+ *  @code
+ *  void function_name(GLFWwindow* window, const char* string)
+ *  @endcode
+ *
+ *  @param[in] window The window that requested the clipboard contents.
+ *  @param[in] string The UTF-8 encoded contents of the clipboard, or `NULL` if
+ *  the clipboard is empty or its contents could not be converted.
+ *
+ *  @pointer_lifetime The string is valid until the callback function returns.
+ *
+ *  @sa @ref clipboard
+ *  @sa @ref glfwRequestClipboardString
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWclipboardfun)(GLFWwindow*,const char*);
+
+/*! @brief The function pointer type for clipboard data release callbacks.
+ *
+ *  This is the function pointer type for clipboard data release callbacks.
+ *  A clipboard data release callback function has the following signature:
+ *  @code
+ *  void function_name(void* data)
+ *  @endcode
+ *
+ *  @param[in] data The data previously passed to @ref glfwSetClipboardData.
+ *
+ *  @sa @ref clipboard
+ *  @sa @ref glfwSetClipboardData
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWclipboardfreefun)(void*);
+
 /*! @brief The function pointer type for monitor configuration callbacks.
  *
  *  This is the function pointer type for monitor configuration callbacks.
@@ -1803,6 +1923,101 @@ typedef struct GLFWgamepadstate
     float axes[6];
 } GLFWgamepadstate;
 
+/*! @brief Mapped framebuffer description.
+ *
+ *  This describes a frame mapped for reading by @ref glfwMapFramebuffer.  The
+ *  pixels are 8-bit RGBA, arranged left-to-right, bottom-to-top.
+ *
+ *  @sa @ref context_readback
+ *  @sa @ref glfwMapFramebuffer
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup context
+ */
+typedef struct GLFWframebufferdesc
+{
+    /*! The width, in pixels, of the frame.
+     */
+    int width;
+    /*! The height, in pixels, of the frame.
+     */
+    int height;
+    /*! The number of bytes from the start of one row to the start of the next.
+     */
+    int stride;
+    /*! The number of the buffer swap that presented the frame, starting at one.
+     */
+    uint64_t frame;
+    /*! The pixel data of the frame.
+     */
+    const unsigned char* pixels;
+} GLFWframebufferdesc;
+
+/*! @brief Frame timing information.
+ *
+ *  This describes when the frames of a window are presented, as returned by
+ *  @ref glfwGetFrameTiming.  All times are in the units of @ref
+ *  glfwGetTimerValue.
+ *
+ *  @sa @ref frame_timing
+ *  @sa @ref glfwGetFrameTiming
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+typedef struct GLFWframetiming
+{
+    /*! The time the most recent frame was presented, or zero if unknown.
+     */
+    uint64_t present;
+    /*! The refresh period of the display, or zero if unknown.
+     */
+    uint64_t refresh;
+    /*! The predicted time of the next vertical blank, or zero if unknown.
+     */
+    uint64_t next;
+    /*! `GLFW_TRUE` if the presentation time was reported by the window system,
+     *  or `GLFW_FALSE` if it was estimated from buffer swaps.
+     */
+    int exact;
+} GLFWframetiming;
+
+/*! @brief Window system and driver call counts.
+ *
+ *  This describes how many of each of five kinds of potentially expensive
+ *  call GLFW has made to the window system and drivers, as returned by @ref
+ *  glfwGetCallCounts.  Calls are neither attributed to GLFW functions nor
+ *  timed.  For the time spent in GLFW functions, see @ref intro_tracing.
+ *
+ *  @sa @ref intro_call_counts
+ *  @sa @ref glfwGetCallCounts
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup init
+ */
+typedef struct GLFWcallcounts
+{
+    /*! The number of requests that waited for a reply from the window system.
+     */
+    uint64_t roundTrips;
+    /*! The number of reads from joystick device files.
+     */
+    uint64_t deviceReads;
+    /*! The number of times the driver made a context current or non-current.
+     */
+    uint64_t makeCurrents;
+    /*! The number of buffer swaps.
+     */
+    uint64_t bufferSwaps;
+    /*! The number of shared memory mappings created for cursor and window
+     *  decoration images.
+     */
+    uint64_t shmMappings;
+} GLFWcallcounts;
+
 
 /*************************************************************************
  * GLFW API functions
@@ -2053,6 +2268,145 @@ GLFWAPI int glfwGetError(const char** description);
  */
 GLFWAPI GLFWerrorfun glfwSetErrorCallback(GLFWerrorfun callback);
 
+/*! @brief Retrieves the window system and driver call counts.
+ *
+ *  This function retrieves the number of round-trips to the window system,
+ *  joystick device reads, context switches, buffer swaps and shared memory
+ *  mappings made by GLFW since it was initialized or since the last call to
+ *  @ref glfwResetCallCounts.
+ *
+ *  Calls are only counted if the library was compiled with the
+ *  [GLFW_CALL_COUNTS](@ref GLFW_CALL_COUNTS) CMake option.  Otherwise this
+ *  function sets all members to zero and returns `GLFW_FALSE`.
+ *
+ *  @param[out] counts Where to store the call counts.
+ *  @return `GLFW_TRUE` if calls are counted, or `GLFW_FALSE`
+ *  otherwise or if an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark @x11 Round-trips are counted as Xlib calls that waited for a reply.
+ *  This includes Xlib calls made by the application on the display returned by
+ *  @ref glfwGetX11Display.  Requests sent by the OpenGL driver directly over
+ *  XCB are not counted.  If the application sets its own after function with
+ *  `XSetAfterFunction` or `XSynchronize`, round-trips are no longer counted.
+ *
+ *  @remark @win32 @macos Round-trips are not counted.
+ *
+ *  @remark Shared memory mappings are only counted on Wayland.
+ *
+ *  @thread_safety This function may be called from any thread.  Calls made on
+ *  other threads at the same time may not be counted.
+ *
+ *  @sa @ref intro_call_counts
+ *  @sa @ref glfwResetCallCounts
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup init
+ */
+GLFWAPI int glfwGetCallCounts(GLFWcallcounts* counts);
+
+/*! @brief Resets the window system and driver call counts.
+ *
+ *  This function sets all the call counts returned by @ref glfwGetCallCounts to
+ *  zero.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref intro_call_counts
+ *  @sa @ref glfwGetCallCounts
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup init
+ */
+GLFWAPI void glfwResetCallCounts(void);
+
+/*! @brief Sets the trace callback.
+ *
+ *  This function sets the trace callback, which is called when GLFW begins or
+ *  ends a traced operation, such as event processing, buffer swaps, context
+ *  switches and the dispatch of window and input callbacks.
+ *
+ *  The callback is called on the thread where the event occurred, which may
+ *  not be the main thread.  Nested operations are reported in order, so the
+ *  events of each thread form a well-formed stack.
+ *
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @callback_signature
+ *  @code
+ *  void callback_name(int type, const char* name, uint64_t time)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [callback pointer type](@ref GLFWtracefun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref intro_tracing
+ *  @sa @ref glfwStartTracing
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup init
+ */
+GLFWAPI GLFWtracefun glfwSetTraceCallback(GLFWtracefun callback);
+
+/*! @brief Starts writing trace events to a file.
+ *
+ *  This function starts writing the trace events of all threads to the
+ *  specified file in the JSON trace event format, which can be loaded into
+ *  Perfetto or `chrome://tracing`.  Any trace file already being written is
+ *  finished first.
+ *
+ *  Each thread collects its events in its own buffer without locking, and
+ *  writes them to the file when the buffer is full or when tracing is stopped.
+ *
+ *  @param[in] path The UTF-8 encoded path of the file to write.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref intro_tracing
+ *  @sa @ref glfwStopTracing
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup init
+ */
+GLFWAPI int glfwStartTracing(const char* path);
+
+/*! @brief Finishes writing trace events to a file.
+ *
+ *  This function writes any buffered trace events and closes the trace file
+ *  opened by @ref glfwStartTracing.  It is called by @ref glfwTerminate.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread, and
+ *  not while other threads are calling GLFW functions.
+ *
+ *  @sa @ref intro_tracing
+ *  @sa @ref glfwStartTracing
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup init
+ */
+GLFWAPI void glfwStopTracing(void);
+
 /*! @brief Returns the currently connected monitors.
  *
  *  This function returns an array of handles for all currently connected
@@ -2901,6 +3255,9 @@ GLFWAPI void glfwSetWindowIcon(GLFWwindow* window, int count, const GLFWimage* i
  *  position of its windows, this function will always emit @ref
  *  GLFW_PLATFORM_ERROR.
  *
+ *  @remark @x11 The position is tracked from window events and does not
+ *  reflect a call to @ref glfwSetWindowPos until events have been processed.
+ *
  *  @thread_safety This function must only be called from the main thread.
  *
  *  @sa @ref window_pos
@@ -2965,6 +3322,9 @@ GLFWAPI void glfwSetWindowPos(GLFWwindow* window, int xpos, int ypos);
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
  *  GLFW_PLATFORM_ERROR.
  *
+ *  @remark @x11 The size is tracked from window events and does not reflect
+ *  a call to @ref glfwSetWindowSize until events have been processed.
+ *
  *  @thread_safety This function must only be called from the main thread.
  *
  *  @sa @ref window_size
@@ -3560,6 +3920,10 @@ GLFWAPI void glfwSetWindowMonitor(GLFWwindow* window, GLFWmonitor* monitor, int
  *  errors.  However, this function should not fail as long as it is passed
  *  valid arguments and the library has been [initialized](@ref intro_init).
  *
+ *  @remark @x11 The focused, hovered, iconified, maximized and visible
+ *  attributes are tracked from window events.  Changes made by the window
+ *  manager or other clients are only reflected once events have been processed.
+ *
  *  @thread_safety This function must only be called from the main thread.
  *
  *  @sa @ref window_attribs
@@ -4408,10 +4772,16 @@ GLFWAPI int glfwGetMouseButton(GLFWwindow* window, int button);
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
  *  GLFW_PLATFORM_ERROR.
  *
+ *  @remark @x11 @wayland The position is tracked from pointer events and is
+ *  the last position the cursor had in the window.  It does not reflect a call
+ *  to @ref glfwSetCursorPos until events have been processed.  Use @ref
+ *  glfwSyncCursorPos to query the current position on X11.
+ *
  *  @thread_safety This function must only be called from the main thread.
  *
  *  @sa @ref cursor_pos
  *  @sa @ref glfwSetCursorPos
+ *  @sa @ref glfwSyncCursorPos
  *
  *  @since Added in version 3.0.  Replaces `glfwGetMousePos`.
  *
@@ -4419,6 +4789,44 @@ GLFWAPI int glfwGetMouseButton(GLFWwindow* window, int button);
  */
 GLFWAPI void glfwGetCursorPos(GLFWwindow* window, double* xpos, double* ypos);
 
+/*! @brief Retrieves the current position of the cursor from the window system.
+ *
+ *  This function queries the window system for the current position of the
+ *  cursor, updates the position tracked by GLFW and returns it the same way as
+ *  @ref glfwGetCursorPos.  This requires a round-trip to the window system on
+ *  some platforms, so only call it when the tracked position is not enough, for
+ *  example right after a call to @ref glfwSetCursorPos or when the cursor may
+ *  have moved outside the window.
+ *
+ *  Any or all of the position arguments may be `NULL`.  If an error occurs, all
+ *  non-`NULL` position arguments will be set to zero.
+ *
+ *  @param[in] window The desired window.
+ *  @param[out] xpos Where to store the cursor x-coordinate, relative to the
+ *  left edge of the content area, or `NULL`.
+ *  @param[out] ypos Where to store the cursor y-coordinate, relative to the to
+ *  top edge of the content area, or `NULL`.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @win32 @macos The cursor position is always retrieved from the
+ *  system, so this function is equivalent to @ref glfwGetCursorPos.
+ *
+ *  @remark @wayland There is no way for an application to query the cursor
+ *  position, so this function is equivalent to @ref glfwGetCursorPos.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref cursor_pos
+ *  @sa @ref glfwGetCursorPos
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwSyncCursorPos(GLFWwindow* window, double* xpos, double* ypos);
+
 /*! @brief Sets the position of the cursor, relative to the content area of the
  *  window.
  *
@@ -4479,6 +4887,11 @@ GLFWAPI void glfwSetCursorPos(GLFWwindow* window, double xpos, double ypos);
  *  @return The handle of the created cursor, or `NULL` if an
  *  [error](@ref error_handling) occurred.
  *
+ *  If a custom cursor with an identical image and hotspot already exists, the
+ *  new cursor shares its native cursor instead of creating another one.  The
+ *  returned handle is still distinct and is destroyed separately, and the
+ *  native cursor is only destroyed with the last cursor using it.
+ *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
  *  GLFW_PLATFORM_ERROR.
  *
@@ -5403,6 +5816,89 @@ GLFWAPI void glfwSetClipboardString(GLFWwindow* window, const char* string);
  */
 GLFWAPI const char* glfwGetClipboardString(GLFWwindow* window);
 
+/*! @brief Requests the contents of the clipboard without blocking.
+ *
+ *  This function starts retrieving the contents of the system clipboard and
+ *  returns immediately.  The specified callback is called with the clipboard
+ *  contents as a UTF-8 encoded string once the transfer has completed, during
+ *  regular event processing.  If the clipboard is empty or its contents
+ *  cannot be converted, the callback receives `NULL` and a @ref
+ *  GLFW_FORMAT_UNAVAILABLE error is generated.
+ *
+ *  Each window may have at most one request pending.  Requesting again before
+ *  the callback has been called replaces the callback of the pending request.
+ *  Requests from several windows are served by a single transfer.
+ *
+ *  @param[in] window The window to associate with the request.
+ *  @param[in] callback The function to call when the transfer has completed.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @win32 @macos The clipboard is read synchronously and the
+ *  callback is called before this function returns.
+ *
+ *  @remark @x11 @wayland Large transfers are read incrementally as data
+ *  arrives, so the event loop is never blocked waiting for the selection
+ *  owner.
+ *
+ *  @pointer_lifetime The string passed to the callback is valid until the
+ *  callback function returns.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref clipboard
+ *  @sa @ref glfwGetClipboardString
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwRequestClipboardString(GLFWwindow* window, GLFWclipboardfun callback);
+
+/*! @brief Sets the clipboard to the specified data without copying it.
+ *
+ *  This function sets the system clipboard to the specified data of the
+ *  specified MIME type.  Where possible the data is referenced instead of
+ *  copied, so it must remain valid until GLFW calls the specified release
+ *  callback.  The callback is called once no more clipboard transfers need the
+ *  data, which may be long after this function has returned, or not until the
+ *  library is terminated.
+ *
+ *  @param[in] mime The MIME type of the data, for example
+ *  `text/plain;charset=utf-8`.
+ *  @param[in] data The data to place on the clipboard.
+ *  @param[in] size The size, in bytes, of the data.
+ *  @param[in] callback The function to call when GLFW no longer needs the
+ *  data, or `NULL` if the data does not need to be released.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_FORMAT_UNAVAILABLE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark If an error occurs, the callback is called before this function
+ *  returns.
+ *
+ *  @remark @wayland Transfers to other clients are written without blocking
+ *  as they drain their pipes, and any MIME type may be offered.
+ *
+ *  @remark @win32 @macos @x11 Only `text/plain;charset=utf-8` and `text/plain`
+ *  data is supported.  The data is copied and the callback is called before
+ *  this function returns.
+ *
+ *  @pointer_lifetime The data must remain valid until the callback is called.
+ *  The MIME type string is copied before this function returns.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref clipboard
+ *  @sa @ref glfwSetClipboardString
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwSetClipboardData(const char* mime, void* data, size_t size, GLFWclipboardfreefun callback);
+
 /*! @brief Returns the GLFW time.
  *
  *  This function returns the current GLFW time, in seconds.  Unless the time
@@ -5532,6 +6028,13 @@ GLFWAPI uint64_t glfwGetTimerFrequency(void);
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
  *  GLFW_NO_WINDOW_CONTEXT and @ref GLFW_PLATFORM_ERROR.
  *
+ *  @remark If the specified context is already current on the calling thread
+ *  according to GLFW, this function does nothing and makes no driver calls.
+ *  This means a context made current or non-current with native API calls,
+ *  such as `glXMakeCurrent` or `eglMakeCurrent`, is not rebound by calling this
+ *  function with the window GLFW last made current.  To rebind it, first call
+ *  this function with `NULL` and then with the window.
+ *
  *  @thread_safety This function may be called from any thread.
  *
  *  @sa @ref context_current
@@ -5553,6 +6056,9 @@ GLFWAPI void glfwMakeContextCurrent(GLFWwindow* window);
  *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
  *
+ *  @remark A context acquired from a [shared context pool](@ref context_pool)
+ *  has no window, so this function returns `NULL` while one is current.
+ *
  *  @thread_safety This function may be called from any thread.
  *
  *  @sa @ref context_current
@@ -5598,6 +6104,145 @@ GLFWAPI GLFWwindow* glfwGetCurrentContext(void);
  */
 GLFWAPI void glfwSwapBuffers(GLFWwindow* window);
 
+/*! @brief Maps the most recent completed frame of the specified window.
+ *
+ *  This function maps the most recently presented frame of the specified
+ *  window for reading by the CPU, without waiting for the GPU.  The frame is
+ *  described by the structure pointed to by `desc`, which is left unmodified if
+ *  no frame could be mapped.
+ *
+ *  For a window with an OSMesa context, the pixels are those of the color buffer
+ *  itself and reflect all rendering up to this call.  Other contexts need the
+ *  [GLFW_READBACK_BUFFERS](@ref GLFW_READBACK_BUFFERS_hint) window hint, which
+ *  makes @ref glfwSwapBuffers queue an asynchronous copy of each frame into
+ *  a ring of pixel buffer objects.  This function maps the newest copy the GPU
+ *  has finished and returns `GLFW_FALSE` without emitting an error if there is
+ *  none yet.
+ *
+ *  The mapping remains valid until @ref glfwUnmapFramebuffer or this function
+ *  is called again for the same window.
+ *
+ *  @param[in] window The window whose framebuffer to map.
+ *  @param[out] desc Where to store the description of the mapped frame.
+ *  @return `GLFW_TRUE` if a frame was mapped, or `GLFW_FALSE` otherwise.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_WINDOW_CONTEXT, @ref GLFW_NO_CURRENT_CONTEXT, @ref
+ *  GLFW_API_UNAVAILABLE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark Except for OSMesa, the context of the specified window must be
+ *  current on the calling thread.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref context_readback
+ *  @sa @ref glfwUnmapFramebuffer
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup context
+ */
+GLFWAPI int glfwMapFramebuffer(GLFWwindow* window, GLFWframebufferdesc* desc);
+
+/*! @brief Unmaps the mapped frame of the specified window.
+ *
+ *  This function releases the frame mapped by @ref glfwMapFramebuffer, allowing
+ *  its buffer to be reused for a later frame.  If no frame is mapped, this
+ *  function does nothing.
+ *
+ *  @param[in] window The window whose framebuffer to unmap.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_WINDOW_CONTEXT, @ref GLFW_NO_CURRENT_CONTEXT and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @remark Except for OSMesa, the context of the specified window must be
+ *  current on the calling thread.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref context_readback
+ *  @sa @ref glfwMapFramebuffer
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup context
+ */
+GLFWAPI void glfwUnmapFramebuffer(GLFWwindow* window);
+
+/*! @brief Retrieves the frame timing of the specified window.
+ *
+ *  This function retrieves when the most recent frame of the specified window
+ *  was presented, the refresh period of its display and the predicted time of
+ *  the next vertical blank, all in the units of @ref glfwGetTimerValue.
+ *
+ *  Where the window system reports presentation times, these are used and the
+ *  `exact` member is set.  Otherwise the presentation time is estimated from
+ *  when the most recent call to @ref glfwSwapBuffers returned, which is only
+ *  meaningful with a swap interval greater than zero, and the refresh period
+ *  is taken from the video mode of the monitor.
+ *
+ *  @param[in] window The window to query.
+ *  @param[out] timing Where to store the frame timing of the window.
+ *  @return `GLFW_TRUE` if the next vertical blank could be predicted, or
+ *  `GLFW_FALSE` otherwise.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @x11 Presentation times are reported for GLX contexts with the
+ *  `GLX_OML_sync_control` extension.  They are the time of the vertical blank
+ *  at which the most recent buffer swap was found to have completed.
+ *
+ *  @remark @wayland Presentation times are reported for windows with an OpenGL
+ *  or OpenGL ES context if the compositor supports the `wp_presentation`
+ *  protocol.  They arrive as events, so are only updated when events are
+ *  processed.  They are only requested for buffer swaps made after the first
+ *  call to this function or @ref glfwWaitForNextFrame for the window.
+ *
+ *  @remark @win32 @macos Presentation times are always estimated.
+ *
+ *  @remark If the window is not full screen, the refresh period is estimated
+ *  from the primary monitor.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref frame_timing
+ *  @sa @ref glfwWaitForNextFrame
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI int glfwGetFrameTiming(GLFWwindow* window, GLFWframetiming* timing);
+
+/*! @brief Waits until the next vertical blank of the specified window.
+ *
+ *  This function puts the calling thread to sleep until the predicted time of
+ *  the next vertical blank of the specified window, as returned by @ref
+ *  glfwGetFrameTiming.  Events received while waiting are processed as if by
+ *  @ref glfwWaitEventsTimeout.
+ *
+ *  If no prediction can be made, this function returns immediately.
+ *
+ *  @param[in] window The window whose next vertical blank to wait for.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @reentrancy This function must not be called from a callback.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref frame_timing
+ *  @sa @ref glfwGetFrameTiming
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwWaitForNextFrame(GLFWwindow* window);
+
 /*! @brief Sets the swap interval for the current context.
  *
  *  This function sets the swap interval for the current OpenGL or OpenGL ES
@@ -5606,11 +6251,11 @@ GLFWAPI void glfwSwapBuffers(GLFWwindow* window);
  *  is sometimes called _vertical synchronization_, _vertical retrace
  *  synchronization_ or just _vsync_.
  *
- *  A context that supports either of the `WGL_EXT_swap_control_tear` and
- *  `GLX_EXT_swap_control_tear` extensions also accepts _negative_ swap
- *  intervals, which allows the driver to swap immediately even if a frame
- *  arrives a little bit late.  You can check for these extensions with @ref
- *  glfwExtensionSupported.
+ *  A context whose [GLFW_CONTEXT_SWAP_TEAR](@ref GLFW_CONTEXT_SWAP_TEAR_attrib)
+ *  attribute is set also accepts _negative_ swap intervals, which swap
+ *  immediately if a frame arrives late instead of waiting for the next
+ *  vertical blank.  Other contexts treat a negative interval as its absolute
+ *  value.
  *
  *  A context must be current on the calling thread.  Calling this function
  *  without a current context will cause a @ref GLFW_NO_CURRENT_CONTEXT error.
@@ -5633,6 +6278,10 @@ GLFWAPI void glfwSwapBuffers(GLFWwindow* window);
  *  because of a user setting that overrides the application's request or due to
  *  bugs in the driver.
  *
+ *  @remark EGL has no late swap tearing extension, so for negative intervals
+ *  GLFW decides for each frame whether it is late, using the time since the
+ *  last buffer swap and the refresh rate of the monitor.
+ *
  *  @thread_safety This function may be called from any thread.
  *
  *  @sa @ref buffer_swap
@@ -5724,6 +6373,125 @@ GLFWAPI int glfwExtensionSupported(const char* extension);
  */
 GLFWAPI GLFWglproc glfwGetProcAddress(const char* procname);
 
+/*! @brief Creates a pool of contexts sharing objects with a window.
+ *
+ *  This function creates a pool of OpenGL or OpenGL ES contexts that share
+ *  objects with the context of the specified window, for use by other threads
+ *  for example to upload textures or buffers in the background.  The contexts
+ *  have the same client API, version, profile and flags as the context of the
+ *  window but no window of their own.  They are made current on a thread with
+ *  @ref glfwAcquireSharedContext and released with @ref
+ *  glfwReleaseSharedContext.
+ *
+ *  Where the context creation API allows it, the contexts are backed by
+ *  a minimal pbuffer or no surface at all, so creating them is much cheaper than
+ *  creating a hidden window for each.  Render to framebuffer objects if you need
+ *  to render with a pooled context.
+ *
+ *  @param[in] window The window whose context to share with.
+ *  @param[in] count The number of contexts in the pool.
+ *  @return The handle of the created pool, or `NULL` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_WINDOW_CONTEXT, @ref GLFW_INVALID_VALUE, @ref GLFW_API_UNAVAILABLE,
+ *  @ref GLFW_VERSION_UNAVAILABLE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @win32 With WGL, the pooled contexts are made current on the device
+ *  context of the window.
+ *
+ *  @remark With OSMesa, the pooled contexts are bound to a single pixel color
+ *  buffer.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref context_pool
+ *  @sa @ref glfwDestroySharedContextPool
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup context
+ */
+GLFWAPI GLFWcontextpool* glfwCreateSharedContextPool(GLFWwindow* window, int count);
+
+/*! @brief Destroys the specified shared context pool.
+ *
+ *  This function destroys the specified shared context pool and all its
+ *  contexts.  If a context of the pool is current on the calling thread, it is
+ *  detached before being destroyed.  A pool is also destroyed when its window
+ *  is destroyed.
+ *
+ *  @param[in] pool The pool to destroy.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @note No context of the pool may be current on any other thread when this
+ *  function is called.
+ *
+ *  @reentrancy This function must not be called from a callback.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref context_pool
+ *  @sa @ref glfwCreateSharedContextPool
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup context
+ */
+GLFWAPI void glfwDestroySharedContextPool(GLFWcontextpool* pool);
+
+/*! @brief Makes a context from the pool current on the calling thread.
+ *
+ *  This function takes a context that is not in use from the specified pool and
+ *  makes it current on the calling thread, releasing any context previously
+ *  current on that thread.  If a context of the pool is already current on the
+ *  calling thread, this function does nothing.
+ *
+ *  This function does not wait for a context to become available.
+ *
+ *  @param[in] pool The pool to acquire a context from.
+ *  @return `GLFW_TRUE` if a context of the pool is now current, or
+ *  `GLFW_FALSE` if every context of the pool is in use or an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref context_pool
+ *  @sa @ref glfwReleaseSharedContext
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup context
+ */
+GLFWAPI int glfwAcquireSharedContext(GLFWcontextpool* pool);
+
+/*! @brief Returns the context current on the calling thread to its pool.
+ *
+ *  This function detaches the context of the specified pool that is current on
+ *  the calling thread and returns it to the pool.  Making another context
+ *  current with @ref glfwMakeContextCurrent also returns it to the pool.
+ *
+ *  @param[in] pool The pool of the current context.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_NO_CURRENT_CONTEXT and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref context_pool
+ *  @sa @ref glfwAcquireSharedContext
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup context
+ */
+GLFWAPI void glfwReleaseSharedContext(GLFWcontextpool* pool);
+
 /*! @brief Returns whether the Vulkan loader and an ICD have been found.
  *
  *  This function returns whether the Vulkan loader and any minimally functional
@@ -5880,6 +6648,48 @@ GLFWAPI GLFWvkproc glfwGetInstanceProcAddress(VkInstance instance, const char* p
  */
 GLFWAPI int glfwGetPhysicalDevicePresentationSupport(VkInstance instance, VkPhysicalDevice device, uint32_t queuefamily);
 
+/*! @brief Returns which queue families of a device can present images.
+ *
+ *  This function returns a bit mask of the queue families of the specified
+ *  physical device that support presentation to the platform GLFW was built
+ *  for.  Bit _n_ of the mask is set if queue family _n_ supports presentation.
+ *  This is equivalent to calling @ref glfwGetPhysicalDevicePresentationSupport
+ *  for every queue family of the device, but is cheaper when querying all of
+ *  them.
+ *
+ *  Only the first 32 queue families of the device are queried.
+ *
+ *  If Vulkan or the required window surface creation instance extensions are
+ *  not available on the machine, or if the specified instance was not created
+ *  with the required extensions, this function returns `GLFW_FALSE`, sets the
+ *  mask to zero and generates a @ref GLFW_API_UNAVAILABLE error.
+ *
+ *  @param[in] instance The instance that the physical device belongs to.
+ *  @param[in] device The physical device to query.
+ *  @param[out] mask Where to store the bit mask of queue families that support
+ *  presentation.
+ *  @return `GLFW_TRUE` if at least one queue family supports presentation, or
+ *  `GLFW_FALSE` otherwise.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_API_UNAVAILABLE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @macos This function currently always sets the bits of every queue
+ *  family, as the `VK_MVK_macos_surface` extension does not provide
+ *  a `vkGetPhysicalDevice*PresentationSupport` type function.
+ *
+ *  @thread_safety This function may be called from any thread.  For
+ *  synchronization details of Vulkan objects, see the Vulkan specification.
+ *
+ *  @sa @ref vulkan_present
+ *  @sa @ref glfwGetPhysicalDevicePresentationSupport
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup vulkan
+ */
+GLFWAPI int glfwGetPhysicalDevicePresentationSupportMask(VkInstance instance, VkPhysicalDevice device, uint32_t* mask);
+
 /*! @brief Creates a Vulkan surface for the specified window.
  *
  *  This function creates a Vulkan surface for the specified window.
@@ -422,6 +422,7 @@ static GLFWbool initializeTIS(void)
     }
 
     _glfwPollMonitorsNS();
+    _glfwInputRefreshChange(NULL);
 }
 
 - (void)applicationWillFinishLaunching:(NSNotification *)notification
@@ -1442,6 +1442,16 @@ void _glfwPlatformPostEmptyEvent(void)
     } // autoreleasepool
 }
 
+void _glfwPlatformRequestPresentTime(_GLFWwindow* window)
+{
+}
+
+GLFWbool _glfwPlatformGetPresentTime(_GLFWwindow* window,
+                                     uint64_t* time, uint64_t* refresh)
+{
+    return GLFW_FALSE;
+}
+
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
 {
     @autoreleasepool {
@@ -1458,6 +1468,11 @@ void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
     } // autoreleasepool
 }
 
+void _glfwPlatformSyncCursorPos(_GLFWwindow* window)
+{
+    // The cursor position is always retrieved from the system
+}
+
 void _glfwPlatformSetCursorPos(_GLFWwindow* window, double x, double y)
 {
     @autoreleasepool {
@@ -1705,6 +1720,17 @@ const char* _glfwPlatformGetClipboardString(void)
     } // autoreleasepool
 }
 
+void _glfwPlatformRequestClipboardString(void)
+{
+    _glfwInputClipboardString(_glfwPlatformGetClipboardString());
+}
+
+void _glfwPlatformSetClipboardData(const char* mime, void* data, size_t size,
+                                   GLFWclipboardfreefun callback)
+{
+    _glfwSetClipboardDataAsString(mime, data, size, callback);
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (_glfw.vk.KHR_surface && _glfw.vk.EXT_metal_surface)
@@ -1719,11 +1745,15 @@ void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
     }
 }
 
-int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
-                                                      VkPhysicalDevice device,
-                                                      uint32_t queuefamily)
+uint32_t _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
+                                                           VkPhysicalDevice device,
+                                                           uint32_t first,
+                                                           uint32_t count)
 {
-    return GLFW_TRUE;
+    uint32_t mask = 0;
+    for (uint32_t i = 0;  i < count;  i++)
+        mask |= 1u << i;
+    return mask;
 }
 
 VkResult _glfwPlatformCreateWindowSurface(VkInstance instance,
@@ -34,6 +34,263 @@
 #include <string.h>
 #include <limits.h>
 #include <stdio.h>
+#include <stdlib.h>
+
+
+// Releases the readback buffer mapped by mapFramebufferGL, if any
+//
+static void unmapFramebufferGL(_GLFWwindow* window)
+{
+    GLint previous;
+    _GLFWreadbackslot* slot;
+
+    if (window->context.readback.mapped == -1)
+        return;
+
+    if (window != _glfwPlatformGetTls(&_glfw.contextSlot))
+    {
+        _glfwInputError(GLFW_NO_CURRENT_CONTEXT,
+                        "The context must be current on the calling thread when unmapping the framebuffer");
+        return;
+    }
+
+    slot = window->context.readback.slots + window->context.readback.mapped;
+    window->context.readback.mapped = -1;
+
+    window->context.GetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &previous);
+    window->context.readback.BindBuffer(GL_PIXEL_PACK_BUFFER, slot->buffer);
+    window->context.readback.UnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    window->context.readback.BindBuffer(GL_PIXEL_PACK_BUFFER, previous);
+}
+
+// Maps the newest readback buffer whose copy the GPU has completed
+//
+static GLFWbool mapFramebufferGL(_GLFWwindow* window, GLFWframebufferdesc* desc)
+{
+    int i;
+    GLint previous;
+    void* pixels;
+    _GLFWreadbackslot* slot = NULL;
+
+    if (window != _glfwPlatformGetTls(&_glfw.contextSlot))
+    {
+        _glfwInputError(GLFW_NO_CURRENT_CONTEXT,
+                        "The context must be current on the calling thread when mapping the framebuffer");
+        return GLFW_FALSE;
+    }
+
+    unmapFramebufferGL(window);
+
+    for (i = 0;  i < window->context.readback.count;  i++)
+    {
+        _GLFWreadbackslot* candidate = window->context.readback.slots + i;
+        GLenum status;
+
+        if (!candidate->sync)
+            continue;
+        if (slot && slot->frame > candidate->frame)
+            continue;
+
+        // A zero timeout polls the fence without ever stalling on the GPU
+        status = window->context.readback.ClientWaitSync(candidate->sync, 0, 0);
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+            slot = candidate;
+    }
+
+    if (!slot)
+        return GLFW_FALSE;
+
+    window->context.GetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &previous);
+    window->context.readback.BindBuffer(GL_PIXEL_PACK_BUFFER, slot->buffer);
+    pixels = window->context.readback.MapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+                                                     (ptrdiff_t) slot->width *
+                                                     slot->height * 4,
+                                                     GL_MAP_READ_BIT);
+    window->context.readback.BindBuffer(GL_PIXEL_PACK_BUFFER, previous);
+
+    if (!pixels)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Failed to map framebuffer readback buffer");
+        return GLFW_FALSE;
+    }
+
+    window->context.readback.mapped =
+        (int) (slot - window->context.readback.slots);
+
+    desc->width = slot->width;
+    desc->height = slot->height;
+    desc->stride = slot->width * 4;
+    desc->frame = slot->frame;
+    desc->pixels = pixels;
+    return GLFW_TRUE;
+}
+
+// Queues an asynchronous copy of the back buffer into the next readback buffer
+//
+static void readFramebufferGL(_GLFWwindow* window)
+{
+    int width, height;
+    GLint pack, read, rowLength, skipRows, skipPixels, alignment;
+    _GLFWreadbackslot* slot;
+
+    if (window->context.readback.next == window->context.readback.mapped)
+    {
+        // Leave the mapped frame alone, dropping this one if it has no company
+        if (window->context.readback.count == 1)
+            return;
+
+        window->context.readback.next = (window->context.readback.next + 1) %
+                                        window->context.readback.count;
+    }
+
+    _glfwPlatformGetFramebufferSize(window, &width, &height);
+    if (!width || !height)
+        return;
+
+    slot = window->context.readback.slots + window->context.readback.next;
+    window->context.readback.next = (window->context.readback.next + 1) %
+                                    window->context.readback.count;
+
+    if (slot->sync)
+    {
+        window->context.readback.DeleteSync(slot->sync);
+        slot->sync = NULL;
+    }
+
+    window->context.GetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &pack);
+    window->context.GetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read);
+    window->context.GetIntegerv(GL_PACK_ROW_LENGTH, &rowLength);
+    window->context.GetIntegerv(GL_PACK_SKIP_ROWS, &skipRows);
+    window->context.GetIntegerv(GL_PACK_SKIP_PIXELS, &skipPixels);
+    window->context.GetIntegerv(GL_PACK_ALIGNMENT, &alignment);
+
+    window->context.readback.BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    window->context.readback.BindBuffer(GL_PIXEL_PACK_BUFFER, slot->buffer);
+    window->context.readback.PixelStorei(GL_PACK_ROW_LENGTH, 0);
+    window->context.readback.PixelStorei(GL_PACK_SKIP_ROWS, 0);
+    window->context.readback.PixelStorei(GL_PACK_SKIP_PIXELS, 0);
+    window->context.readback.PixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    if (slot->width != width || slot->height != height)
+    {
+        window->context.readback.BufferData(GL_PIXEL_PACK_BUFFER,
+                                            (ptrdiff_t) width * height * 4,
+                                            NULL, GL_STREAM_READ);
+        slot->width = width;
+        slot->height = height;
+    }
+
+    // The copy targets the bound buffer object, so this returns immediately
+    // and the fence tells when the GPU has caught up
+    window->context.readback.ReadPixels(0, 0, width, height,
+                                        GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    slot->sync =
+        window->context.readback.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot->frame = window->context.frames + 1;
+
+    window->context.readback.PixelStorei(GL_PACK_ROW_LENGTH, rowLength);
+    window->context.readback.PixelStorei(GL_PACK_SKIP_ROWS, skipRows);
+    window->context.readback.PixelStorei(GL_PACK_SKIP_PIXELS, skipPixels);
+    window->context.readback.PixelStorei(GL_PACK_ALIGNMENT, alignment);
+    window->context.readback.BindBuffer(GL_PIXEL_PACK_BUFFER, pack);
+    window->context.readback.BindFramebuffer(GL_READ_FRAMEBUFFER, read);
+}
+
+// Creates the ring of readback buffers for the current context
+//
+static GLFWbool createReadbackGL(_GLFWwindow* window, int count)
+{
+    int i;
+
+    if (window->context.client == GLFW_OPENGL_API)
+    {
+        if (window->context.major < 3 ||
+            (window->context.major == 3 && window->context.minor < 2))
+        {
+            _glfwInputError(GLFW_VERSION_UNAVAILABLE,
+                            "Framebuffer readback requires OpenGL 3.2 or later");
+            return GLFW_FALSE;
+        }
+    }
+    else
+    {
+        if (window->context.major < 3)
+        {
+            _glfwInputError(GLFW_VERSION_UNAVAILABLE,
+                            "Framebuffer readback requires OpenGL ES 3.0 or later");
+            return GLFW_FALSE;
+        }
+    }
+
+    window->context.readback.PixelStorei = (PFNGLPIXELSTOREIPROC)
+        window->context.getProcAddress("glPixelStorei");
+    window->context.readback.ReadPixels = (PFNGLREADPIXELSPROC)
+        window->context.getProcAddress("glReadPixels");
+    window->context.readback.GenBuffers = (PFNGLGENBUFFERSPROC)
+        window->context.getProcAddress("glGenBuffers");
+    window->context.readback.DeleteBuffers = (PFNGLDELETEBUFFERSPROC)
+        window->context.getProcAddress("glDeleteBuffers");
+    window->context.readback.BindBuffer = (PFNGLBINDBUFFERPROC)
+        window->context.getProcAddress("glBindBuffer");
+    window->context.readback.BufferData = (PFNGLBUFFERDATAPROC)
+        window->context.getProcAddress("glBufferData");
+    window->context.readback.MapBufferRange = (PFNGLMAPBUFFERRANGEPROC)
+        window->context.getProcAddress("glMapBufferRange");
+    window->context.readback.UnmapBuffer = (PFNGLUNMAPBUFFERPROC)
+        window->context.getProcAddress("glUnmapBuffer");
+    window->context.readback.BindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)
+        window->context.getProcAddress("glBindFramebuffer");
+    window->context.readback.FenceSync = (PFNGLFENCESYNCPROC)
+        window->context.getProcAddress("glFenceSync");
+    window->context.readback.ClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)
+        window->context.getProcAddress("glClientWaitSync");
+    window->context.readback.DeleteSync = (PFNGLDELETESYNCPROC)
+        window->context.getProcAddress("glDeleteSync");
+
+    if (!window->context.readback.PixelStorei ||
+        !window->context.readback.ReadPixels ||
+        !window->context.readback.GenBuffers ||
+        !window->context.readback.DeleteBuffers ||
+        !window->context.readback.BindBuffer ||
+        !window->context.readback.BufferData ||
+        !window->context.readback.MapBufferRange ||
+        !window->context.readback.UnmapBuffer ||
+        !window->context.readback.BindFramebuffer ||
+        !window->context.readback.FenceSync ||
+        !window->context.readback.ClientWaitSync ||
+        !window->context.readback.DeleteSync)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR, "Entry point retrieval is broken");
+        return GLFW_FALSE;
+    }
+
+    window->context.readback.slots = calloc(count, sizeof(_GLFWreadbackslot));
+    window->context.readback.count = count;
+    window->context.readback.next = 0;
+    window->context.readback.mapped = -1;
+
+    for (i = 0;  i < count;  i++)
+    {
+        window->context.readback.GenBuffers(1,
+            &window->context.readback.slots[i].buffer);
+    }
+
+    window->context.mapFramebuffer = mapFramebufferGL;
+    window->context.unmapFramebuffer = unmapFramebufferGL;
+    return GLFW_TRUE;
+}
+
+// Marks a pooled context as no longer held by any thread
+//
+static void returnPooledContext(_GLFWwindow* context)
+{
+    _GLFWcontextpool* pool = context->context.pool;
+
+    _glfwPlatformLockMutex(&pool->lock);
+    pool->acquired[context - pool->contexts] = GLFW_FALSE;
+    _glfwPlatformUnlockMutex(&pool->lock);
+}
 
 
 //////////////////////////////////////////////////////////////////////////
@@ -573,10 +830,49 @@ GLFWbool _glfwRefreshContextAttribs(_GLFWwindow* window,
         window->context.swapBuffers(window);
     }
 
+    // Contexts that can map their framebuffer directly need no readback ring
+    if (ctxconfig->readback > 0 && !window->context.mapFramebuffer)
+    {
+        if (!createReadbackGL(window, ctxconfig->readback))
+        {
+            glfwMakeContextCurrent((GLFWwindow*) previous);
+            return GLFW_FALSE;
+        }
+    }
+
     glfwMakeContextCurrent((GLFWwindow*) previous);
     return GLFW_TRUE;
 }
 
+// Releases the readback ring of the specified window
+//
+// The buffer objects and fences are only deleted if the context is current on
+// the calling thread, otherwise they are released along with the context
+//
+void _glfwDestroyReadbackGL(_GLFWwindow* window)
+{
+    int i;
+
+    if (window == _glfwPlatformGetTls(&_glfw.contextSlot))
+    {
+        unmapFramebufferGL(window);
+
+        for (i = 0;  i < window->context.readback.count;  i++)
+        {
+            _GLFWreadbackslot* slot = window->context.readback.slots + i;
+
+            if (slot->sync)
+                window->context.readback.DeleteSync(slot->sync);
+
+            window->context.readback.DeleteBuffers(1, &slot->buffer);
+        }
+    }
+
+    free(window->context.readback.slots);
+    window->context.readback.slots = NULL;
+    window->context.readback.count = 0;
+}
+
 // Searches an extension string for the specified extension
 //
 GLFWbool _glfwStringInExtensionString(const char* string, const char* extensions)
@@ -613,7 +909,7 @@ GLFWbool _glfwStringInExtensionString(const char* string, const char* extensions
 GLFWAPI void glfwMakeContextCurrent(GLFWwindow* handle)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
-    _GLFWwindow* previous = _glfwPlatformGetTls(&_glfw.contextSlot);
+    _GLFWwindow* previous;
 
     _GLFW_REQUIRE_INIT();
 
@@ -624,6 +920,15 @@ GLFWAPI void glfwMakeContextCurrent(GLFWwindow* handle)
         return;
     }
 
+    previous = _glfwPlatformGetTls(&_glfw.contextSlot);
+
+    // Rebinding the context already current on this thread releases nothing,
+    // so there is no flush to honor and the driver call can be skipped
+    if (window == previous)
+        return;
+
+    _GLFW_TRACE_BEGIN("glfwMakeContextCurrent");
+
     if (previous)
     {
         if (!window || window->context.source != previous->context.source)
@@ -632,12 +937,26 @@ GLFWAPI void glfwMakeContextCurrent(GLFWwindow* handle)
 
     if (window)
         window->context.makeCurrent(window);
+
+    if (previous && previous->context.pool)
+        returnPooledContext(previous);
+
+    _GLFW_TRACE_END("glfwMakeContextCurrent");
 }
 
 GLFWAPI GLFWwindow* glfwGetCurrentContext(void)
 {
+    _GLFWwindow* window;
+
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
-    return _glfwPlatformGetTls(&_glfw.contextSlot);
+
+    window = _glfwPlatformGetTls(&_glfw.contextSlot);
+
+    // A pooled context has no window that could be returned
+    if (window && window->context.pool)
+        return NULL;
+
+    return (GLFWwindow*) window;
 }
 
 GLFWAPI void glfwSwapBuffers(GLFWwindow* handle)
@@ -654,7 +973,63 @@ GLFWAPI void glfwSwapBuffers(GLFWwindow* handle)
         return;
     }
 
+    if (window->context.readback.count &&
+        window == _glfwPlatformGetTls(&_glfw.contextSlot))
+    {
+        readFramebufferGL(window);
+    }
+
+    _glfwPlatformRequestPresentTime(window);
+
+    _GLFW_COUNT(bufferSwaps);
+    _GLFW_TRACE_BEGIN("glfwSwapBuffers");
     window->context.swapBuffers(window);
+    _GLFW_TRACE_END("glfwSwapBuffers");
+    window->context.frames++;
+    window->timing.swapped = _glfwPlatformGetTimerValue();
+}
+
+GLFWAPI int glfwMapFramebuffer(GLFWwindow* handle, GLFWframebufferdesc* desc)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(desc != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (window->context.client == GLFW_NO_API)
+    {
+        _glfwInputError(GLFW_NO_WINDOW_CONTEXT,
+                        "Cannot map the framebuffer of a window that has no OpenGL or OpenGL ES context");
+        return GLFW_FALSE;
+    }
+
+    if (!window->context.mapFramebuffer)
+    {
+        _glfwInputError(GLFW_API_UNAVAILABLE,
+                        "Framebuffer readback was not requested for this window");
+        return GLFW_FALSE;
+    }
+
+    return window->context.mapFramebuffer(window, desc);
+}
+
+GLFWAPI void glfwUnmapFramebuffer(GLFWwindow* handle)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (window->context.client == GLFW_NO_API)
+    {
+        _glfwInputError(GLFW_NO_WINDOW_CONTEXT,
+                        "Cannot unmap the framebuffer of a window that has no OpenGL or OpenGL ES context");
+        return;
+    }
+
+    if (window->context.unmapFramebuffer)
+        window->context.unmapFramebuffer(window);
 }
 
 GLFWAPI void glfwSwapInterval(int interval)
@@ -671,7 +1046,13 @@ GLFWAPI void glfwSwapInterval(int interval)
         return;
     }
 
-    window->context.swapInterval(interval);
+    // Contexts without late swap tearing wait for the vertical blank instead
+    if (interval < 0 && !window->context.swapTear)
+        interval = -interval;
+
+    // Pooled contexts have nothing to present
+    if (window->context.swapInterval)
+        window->context.swapInterval(interval);
 }
 
 GLFWAPI int glfwExtensionSupported(const char* extension)
@@ -758,3 +1139,196 @@ GLFWAPI GLFWglproc glfwGetProcAddress(const char* procname)
     return window->context.getProcAddress(procname);
 }
 
+GLFWAPI GLFWcontextpool* glfwCreateSharedContextPool(GLFWwindow* handle,
+                                                     int count)
+{
+    int i;
+    _GLFWctxconfig ctxconfig;
+    _GLFWcontextpool* pool;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    if (window->context.client == GLFW_NO_API)
+    {
+        _glfwInputError(GLFW_NO_WINDOW_CONTEXT,
+                        "Cannot create a shared context pool for a window that has no OpenGL or OpenGL ES context");
+        return NULL;
+    }
+
+    if (count < 1)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid shared context pool size %i", count);
+        return NULL;
+    }
+
+    if (!window->context.createShared)
+    {
+        _glfwInputError(GLFW_API_UNAVAILABLE,
+                        "The context creation API of the window does not support shared context pools");
+        return NULL;
+    }
+
+    // The pooled contexts are created with the attributes the context of the
+    // window actually got, which satisfy those it was requested with
+    memset(&ctxconfig, 0, sizeof(ctxconfig));
+    ctxconfig.client     = window->context.client;
+    ctxconfig.source     = window->context.source;
+    ctxconfig.major      = window->context.major;
+    ctxconfig.minor      = window->context.minor;
+    ctxconfig.forward    = window->context.forward;
+    ctxconfig.debug      = window->context.debug;
+    ctxconfig.noerror    = window->context.noerror;
+    ctxconfig.profile    = window->context.profile;
+    ctxconfig.robustness = window->context.robustness;
+    ctxconfig.release    = window->context.release;
+    ctxconfig.share      = window;
+
+    pool = calloc(1, sizeof(_GLFWcontextpool));
+    pool->next = _glfw.contextPoolListHead;
+    _glfw.contextPoolListHead = pool;
+
+    pool->window = window;
+    pool->contexts = calloc(count, sizeof(_GLFWwindow));
+    pool->acquired = calloc(count, sizeof(GLFWbool));
+
+    if (!_glfwPlatformCreateMutex(&pool->lock))
+    {
+        glfwDestroySharedContextPool((GLFWcontextpool*) pool);
+        return NULL;
+    }
+
+    for (i = 0;  i < count;  i++)
+    {
+        _GLFWwindow* context = pool->contexts + i;
+
+        context->context.client      = window->context.client;
+        context->context.source      = window->context.source;
+        context->context.major       = window->context.major;
+        context->context.minor       = window->context.minor;
+        context->context.revision    = window->context.revision;
+        context->context.forward     = window->context.forward;
+        context->context.debug       = window->context.debug;
+        context->context.noerror     = window->context.noerror;
+        context->context.profile     = window->context.profile;
+        context->context.robustness  = window->context.robustness;
+        context->context.release     = window->context.release;
+        context->context.GetStringi  = window->context.GetStringi;
+        context->context.GetIntegerv = window->context.GetIntegerv;
+        context->context.GetString   = window->context.GetString;
+        context->context.pool        = pool;
+
+        if (!window->context.createShared(context, &ctxconfig))
+        {
+            glfwDestroySharedContextPool((GLFWcontextpool*) pool);
+            return NULL;
+        }
+
+        pool->count++;
+    }
+
+    return (GLFWcontextpool*) pool;
+}
+
+GLFWAPI void glfwDestroySharedContextPool(GLFWcontextpool* handle)
+{
+    int i;
+    _GLFWwindow* current;
+    _GLFWcontextpool* pool = (_GLFWcontextpool*) handle;
+
+    _GLFW_REQUIRE_INIT();
+
+    // Allow destroying of NULL (to match the behavior of free)
+    if (pool == NULL)
+        return;
+
+    current = _glfwPlatformGetTls(&_glfw.contextSlot);
+    if (current && current->context.pool == pool)
+        current->context.makeCurrent(NULL);
+
+    for (i = 0;  i < pool->count;  i++)
+    {
+        _GLFWwindow* context = pool->contexts + i;
+        context->context.destroy(context);
+    }
+
+    _glfwPlatformDestroyMutex(&pool->lock);
+
+    // Unlink pool from global linked list
+    {
+        _GLFWcontextpool** prev = &_glfw.contextPoolListHead;
+
+        while (*prev != pool)
+            prev = &((*prev)->next);
+
+        *prev = pool->next;
+    }
+
+    free(pool->contexts);
+    free(pool->acquired);
+    free(pool);
+}
+
+GLFWAPI int glfwAcquireSharedContext(GLFWcontextpool* handle)
+{
+    int i;
+    _GLFWwindow* context = NULL;
+    _GLFWwindow* previous;
+    _GLFWcontextpool* pool = (_GLFWcontextpool*) handle;
+    assert(pool != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    previous = _glfwPlatformGetTls(&_glfw.contextSlot);
+    if (previous && previous->context.pool == pool)
+        return GLFW_TRUE;
+
+    _glfwPlatformLockMutex(&pool->lock);
+
+    for (i = 0;  i < pool->count;  i++)
+    {
+        if (!pool->acquired[i])
+        {
+            pool->acquired[i] = GLFW_TRUE;
+            context = pool->contexts + i;
+            break;
+        }
+    }
+
+    _glfwPlatformUnlockMutex(&pool->lock);
+
+    if (!context)
+        return GLFW_FALSE;
+
+    glfwMakeContextCurrent((GLFWwindow*) context);
+
+    if (context != _glfwPlatformGetTls(&_glfw.contextSlot))
+    {
+        returnPooledContext(context);
+        return GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
+}
+
+GLFWAPI void glfwReleaseSharedContext(GLFWcontextpool* handle)
+{
+    _GLFWwindow* context;
+    _GLFWcontextpool* pool = (_GLFWcontextpool*) handle;
+    assert(pool != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    context = _glfwPlatformGetTls(&_glfw.contextSlot);
+    if (!context || context->context.pool != pool)
+    {
+        _glfwInputError(GLFW_NO_CURRENT_CONTEXT,
+                        "No context of the pool is current on the calling thread");
+        return;
+    }
+
+    glfwMakeContextCurrent(NULL);
+}
+
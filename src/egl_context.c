@@ -118,9 +118,19 @@ static GLFWbool chooseEGLConfig(const _GLFWctxconfig* ctxconfig,
         if (getEGLConfigAttrib(n, EGL_COLOR_BUFFER_TYPE) != EGL_RGB_BUFFER)
             continue;
 
+#if defined(_GLFW_OSMESA)
+        // Only consider pbuffer EGLConfigs, unless the context can be made
+        // current without any surface
+        if (!(getEGLConfigAttrib(n, EGL_SURFACE_TYPE) & EGL_PBUFFER_BIT) &&
+            !_glfw.egl.KHR_surfaceless_context)
+        {
+            continue;
+        }
+#else
         // Only consider window EGLConfigs
         if (!(getEGLConfigAttrib(n, EGL_SURFACE_TYPE) & EGL_WINDOW_BIT))
             continue;
+#endif // _GLFW_OSMESA
 
 #if defined(_GLFW_X11)
         {
@@ -191,6 +201,8 @@ static GLFWbool chooseEGLConfig(const _GLFWctxconfig* ctxconfig,
 
 static void makeContextCurrentEGL(_GLFWwindow* window)
 {
+    _GLFW_COUNT(makeCurrents);
+
     if (window)
     {
         if (!eglMakeCurrent(_glfw.egl.display,
@@ -230,12 +242,43 @@ static void swapBuffersEGL(_GLFWwindow* window)
         return;
     }
 
+    // A surfaceless context has no default framebuffer to present
+    if (window->context.egl.surface == EGL_NO_SURFACE)
+        return;
+
+    // EGL has no late swap tearing, so it is emulated by presenting a frame
+    // immediately if it has already missed the vertical blank it was meant for
+    // This only reads the cached refresh period, as buffers may be swapped on
+    // any thread, and is skipped while that period is unknown
+    if (window->context.egl.interval < 0)
+    {
+        int interval = -window->context.egl.interval;
+        const uint64_t period = _glfwGetRefreshPeriod(window) * interval;
+
+        if (period && window->timing.swapped &&
+            _glfwPlatformGetTimerValue() - window->timing.swapped > period)
+        {
+            interval = 0;
+        }
+
+        if (window->context.egl.effective != interval)
+        {
+            eglSwapInterval(_glfw.egl.display, interval);
+            window->context.egl.effective = interval;
+        }
+    }
+
     eglSwapBuffers(_glfw.egl.display, window->context.egl.surface);
 }
 
 static void swapIntervalEGL(int interval)
 {
-    eglSwapInterval(_glfw.egl.display, interval);
+    _GLFWwindow* window = _glfwPlatformGetTls(&_glfw.contextSlot);
+
+    window->context.egl.interval = interval;
+    window->context.egl.effective = abs(interval);
+
+    eglSwapInterval(_glfw.egl.display, window->context.egl.effective);
 }
 
 static int extensionSupportedEGL(const char* extension)
@@ -294,6 +337,35 @@ static void destroyContextEGL(_GLFWwindow* window)
 }
 
 
+#if defined(_GLFW_OSMESA)
+// Returns an EGLDisplay not tied to any window system, preferring the Mesa
+// surfaceless platform over whatever the default display is
+//
+static EGLDisplay getHeadlessDisplay(void)
+{
+    const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (extensions &&
+        _glfwStringInExtensionString("EGL_EXT_platform_base", extensions) &&
+        _glfwStringInExtensionString("EGL_MESA_platform_surfaceless", extensions))
+    {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+            (PFNEGLGETPLATFORMDISPLAYEXTPROC)
+            eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay)
+        {
+            EGLDisplay display =
+                getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+                                   EGL_DEFAULT_DISPLAY, NULL);
+            if (display != EGL_NO_DISPLAY)
+                return display;
+        }
+    }
+
+    return eglGetDisplay(_GLFW_EGL_NATIVE_DISPLAY);
+}
+#endif // _GLFW_OSMESA
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
@@ -370,6 +442,8 @@ GLFWbool _glfwInitEGL(void)
         _glfw_dlsym(_glfw.egl.handle, "eglQueryString");
     _glfw.egl.GetProcAddress = (PFN_eglGetProcAddress)
         _glfw_dlsym(_glfw.egl.handle, "eglGetProcAddress");
+    _glfw.egl.CreatePbufferSurface = (PFN_eglCreatePbufferSurface)
+        _glfw_dlsym(_glfw.egl.handle, "eglCreatePbufferSurface");
 
     if (!_glfw.egl.GetConfigAttrib ||
         !_glfw.egl.GetConfigs ||
@@ -386,7 +460,8 @@ GLFWbool _glfwInitEGL(void)
         !_glfw.egl.SwapBuffers ||
         !_glfw.egl.SwapInterval ||
         !_glfw.egl.QueryString ||
-        !_glfw.egl.GetProcAddress)
+        !_glfw.egl.GetProcAddress ||
+        !_glfw.egl.CreatePbufferSurface)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
                         "EGL: Failed to load required entry points");
@@ -395,7 +470,11 @@ GLFWbool _glfwInitEGL(void)
         return GLFW_FALSE;
     }
 
+#if defined(_GLFW_OSMESA)
+    _glfw.egl.display = getHeadlessDisplay();
+#else
     _glfw.egl.display = eglGetDisplay(_GLFW_EGL_NATIVE_DISPLAY);
+#endif
     if (_glfw.egl.display == EGL_NO_DISPLAY)
     {
         _glfwInputError(GLFW_API_UNAVAILABLE,
@@ -426,6 +505,8 @@ GLFWbool _glfwInitEGL(void)
         extensionSupportedEGL("EGL_KHR_get_all_proc_addresses");
     _glfw.egl.KHR_context_flush_control =
         extensionSupportedEGL("EGL_KHR_context_flush_control");
+    _glfw.egl.KHR_surfaceless_context =
+        extensionSupportedEGL("EGL_KHR_surfaceless_context");
 
     return GLFW_TRUE;
 }
@@ -454,33 +535,105 @@ void _glfwTerminateEGL(void)
     attribs[index++] = v; \
 }
 
-// Create the OpenGL or OpenGL ES context
+// Loads the client library of the context, as not every EGL implementation
+// returns core functions from eglGetProcAddress
 //
-GLFWbool _glfwCreateContextEGL(_GLFWwindow* window,
-                               const _GLFWctxconfig* ctxconfig,
-                               const _GLFWfbconfig* fbconfig)
+static GLFWbool loadClientLibraryEGL(_GLFWwindow* window,
+                                     const _GLFWctxconfig* ctxconfig)
+{
+    if (!_glfw.egl.KHR_get_all_proc_addresses)
+    {
+        int i;
+        const char** sonames;
+        const char* es1sonames[] =
+        {
+#if defined(_GLFW_GLESV1_LIBRARY)
+            _GLFW_GLESV1_LIBRARY,
+#elif defined(_GLFW_WIN32)
+            "GLESv1_CM.dll",
+            "libGLES_CM.dll",
+#elif defined(_GLFW_COCOA)
+            "libGLESv1_CM.dylib",
+#else
+            "libGLESv1_CM.so.1",
+            "libGLES_CM.so.1",
+#endif
+            NULL
+        };
+        const char* es2sonames[] =
+        {
+#if defined(_GLFW_GLESV2_LIBRARY)
+            _GLFW_GLESV2_LIBRARY,
+#elif defined(_GLFW_WIN32)
+            "GLESv2.dll",
+            "libGLESv2.dll",
+#elif defined(_GLFW_COCOA)
+            "libGLESv2.dylib",
+#elif defined(__CYGWIN__)
+            "libGLESv2-2.so",
+#else
+            "libGLESv2.so.2",
+#endif
+            NULL
+        };
+        const char* glsonames[] =
+        {
+#if defined(_GLFW_OPENGL_LIBRARY)
+            _GLFW_OPENGL_LIBRARY,
+#elif defined(_GLFW_WIN32)
+#elif defined(_GLFW_COCOA)
+#else
+            "libGL.so.1",
+#endif
+            NULL
+        };
+
+        if (ctxconfig->client == GLFW_OPENGL_ES_API)
+        {
+            if (ctxconfig->major == 1)
+                sonames = es1sonames;
+            else
+                sonames = es2sonames;
+        }
+        else
+            sonames = glsonames;
+
+        for (i = 0;  sonames[i];  i++)
+        {
+            // HACK: Match presence of lib prefix to increase chance of finding
+            //       a matching pair in the jungle that is Win32 EGL/GLES
+            if (_glfw.egl.prefix != (strncmp(sonames[i], "lib", 3) == 0))
+                continue;
+
+            window->context.egl.client = _glfw_dlopen(sonames[i]);
+            if (window->context.egl.client)
+                break;
+        }
+
+        if (!window->context.egl.client)
+        {
+            _glfwInputError(GLFW_API_UNAVAILABLE,
+                            "EGL: Failed to load client library");
+            return GLFW_FALSE;
+        }
+    }
+
+    return GLFW_TRUE;
+}
+
+// Creates the OpenGL or OpenGL ES context for the specified EGLConfig
+//
+static GLFWbool createContextEGL(_GLFWwindow* window,
+                                 const _GLFWctxconfig* ctxconfig,
+                                 EGLConfig config)
 {
     EGLint attribs[40];
-    EGLConfig config;
     EGLContext share = NULL;
     int index = 0;
 
-    if (!_glfw.egl.display)
-    {
-        _glfwInputError(GLFW_API_UNAVAILABLE, "EGL: API not available");
-        return GLFW_FALSE;
-    }
-
     if (ctxconfig->share)
         share = ctxconfig->share->context.egl.handle;
 
-    if (!chooseEGLConfig(ctxconfig, fbconfig, &config))
-    {
-        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
-                        "EGL: Failed to find a suitable EGLConfig");
-        return GLFW_FALSE;
-    }
-
     if (ctxconfig->client == GLFW_OPENGL_ES_API)
     {
         if (!eglBindAPI(EGL_OPENGL_ES_API))
@@ -587,6 +740,84 @@ GLFWbool _glfwCreateContextEGL(_GLFWwindow* window,
         return GLFW_FALSE;
     }
 
+    window->context.egl.config = config;
+    return GLFW_TRUE;
+}
+
+// Creates a pooled context sharing objects with the specified window
+//
+static GLFWbool createSharedContextEGL(_GLFWwindow* context,
+                                       const _GLFWctxconfig* ctxconfig)
+{
+    const EGLConfig config = ctxconfig->share->context.egl.config;
+
+    if (!createContextEGL(context, ctxconfig, config))
+        return GLFW_FALSE;
+
+    // Without pbuffer support the context is made current without a surface,
+    // which needs EGL_KHR_surfaceless_context
+    if (getEGLConfigAttrib(config, EGL_SURFACE_TYPE) & EGL_PBUFFER_BIT)
+    {
+        const EGLint attribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+
+        context->context.egl.surface =
+            eglCreatePbufferSurface(_glfw.egl.display, config, attribs);
+        if (context->context.egl.surface == EGL_NO_SURFACE)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "EGL: Failed to create pbuffer surface: %s",
+                            getEGLErrorString(eglGetError()));
+            destroyContextEGL(context);
+            return GLFW_FALSE;
+        }
+    }
+    else if (!_glfw.egl.KHR_surfaceless_context)
+    {
+        _glfwInputError(GLFW_API_UNAVAILABLE,
+                        "EGL: Pooled contexts need pbuffers or EGL_KHR_surfaceless_context");
+        destroyContextEGL(context);
+        return GLFW_FALSE;
+    }
+
+    if (!loadClientLibraryEGL(context, ctxconfig))
+    {
+        destroyContextEGL(context);
+        return GLFW_FALSE;
+    }
+
+    context->context.makeCurrent = makeContextCurrentEGL;
+    context->context.extensionSupported = extensionSupportedEGL;
+    context->context.getProcAddress = getProcAddressEGL;
+    context->context.destroy = destroyContextEGL;
+
+    return GLFW_TRUE;
+}
+
+// Create the OpenGL or OpenGL ES context
+//
+GLFWbool _glfwCreateContextEGL(_GLFWwindow* window,
+                               const _GLFWctxconfig* ctxconfig,
+                               const _GLFWfbconfig* fbconfig)
+{
+    EGLint attribs[40];
+    EGLConfig config;
+
+    if (!_glfw.egl.display)
+    {
+        _glfwInputError(GLFW_API_UNAVAILABLE, "EGL: API not available");
+        return GLFW_FALSE;
+    }
+
+    if (!chooseEGLConfig(ctxconfig, fbconfig, &config))
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "EGL: Failed to find a suitable EGLConfig");
+        return GLFW_FALSE;
+    }
+
+    if (!createContextEGL(window, ctxconfig, config))
+        return GLFW_FALSE;
+
     // Set up attributes for surface creation
     {
         int index = 0;
@@ -597,9 +828,35 @@ GLFWbool _glfwCreateContextEGL(_GLFWwindow* window,
                 setAttrib(EGL_GL_COLORSPACE_KHR, EGL_GL_COLORSPACE_SRGB_KHR);
         }
 
+#if defined(_GLFW_OSMESA)
+        {
+            int width, height;
+            _glfwPlatformGetFramebufferSize(window, &width, &height);
+            setAttrib(EGL_WIDTH, width);
+            setAttrib(EGL_HEIGHT, height);
+        }
+#endif // _GLFW_OSMESA
+
         setAttrib(EGL_NONE, EGL_NONE);
     }
 
+#if defined(_GLFW_OSMESA)
+    // Back the context with a window-sized pbuffer where the EGLConfig allows
+    // it, as that provides a default framebuffer to render to and read back
+    // from, otherwise leave it surfaceless and let the application use FBOs
+    if (getEGLConfigAttrib(config, EGL_SURFACE_TYPE) & EGL_PBUFFER_BIT)
+    {
+        window->context.egl.surface =
+            eglCreatePbufferSurface(_glfw.egl.display, config, attribs);
+        if (window->context.egl.surface == EGL_NO_SURFACE)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "EGL: Failed to create pbuffer surface: %s",
+                            getEGLErrorString(eglGetError()));
+            return GLFW_FALSE;
+        }
+    }
+#else
     window->context.egl.surface =
         eglCreateWindowSurface(_glfw.egl.display,
                                config,
@@ -613,85 +870,13 @@ GLFWbool _glfwCreateContextEGL(_GLFWwindow* window,
         return GLFW_FALSE;
     }
 
-    window->context.egl.config = config;
+    // Late swap tearing needs a swap interval of zero for late frames
+    window->context.swapTear =
+        getEGLConfigAttrib(config, EGL_MIN_SWAP_INTERVAL) == 0;
+#endif // _GLFW_OSMESA
 
-    // Load the appropriate client library
-    if (!_glfw.egl.KHR_get_all_proc_addresses)
-    {
-        int i;
-        const char** sonames;
-        const char* es1sonames[] =
-        {
-#if defined(_GLFW_GLESV1_LIBRARY)
-            _GLFW_GLESV1_LIBRARY,
-#elif defined(_GLFW_WIN32)
-            "GLESv1_CM.dll",
-            "libGLES_CM.dll",
-#elif defined(_GLFW_COCOA)
-            "libGLESv1_CM.dylib",
-#else
-            "libGLESv1_CM.so.1",
-            "libGLES_CM.so.1",
-#endif
-            NULL
-        };
-        const char* es2sonames[] =
-        {
-#if defined(_GLFW_GLESV2_LIBRARY)
-            _GLFW_GLESV2_LIBRARY,
-#elif defined(_GLFW_WIN32)
-            "GLESv2.dll",
-            "libGLESv2.dll",
-#elif defined(_GLFW_COCOA)
-            "libGLESv2.dylib",
-#elif defined(__CYGWIN__)
-            "libGLESv2-2.so",
-#else
-            "libGLESv2.so.2",
-#endif
-            NULL
-        };
-        const char* glsonames[] =
-        {
-#if defined(_GLFW_OPENGL_LIBRARY)
-            _GLFW_OPENGL_LIBRARY,
-#elif defined(_GLFW_WIN32)
-#elif defined(_GLFW_COCOA)
-#else
-            "libGL.so.1",
-#endif
-            NULL
-        };
-
-        if (ctxconfig->client == GLFW_OPENGL_ES_API)
-        {
-            if (ctxconfig->major == 1)
-                sonames = es1sonames;
-            else
-                sonames = es2sonames;
-        }
-        else
-            sonames = glsonames;
-
-        for (i = 0;  sonames[i];  i++)
-        {
-            // HACK: Match presence of lib prefix to increase chance of finding
-            //       a matching pair in the jungle that is Win32 EGL/GLES
-            if (_glfw.egl.prefix != (strncmp(sonames[i], "lib", 3) == 0))
-                continue;
-
-            window->context.egl.client = _glfw_dlopen(sonames[i]);
-            if (window->context.egl.client)
-                break;
-        }
-
-        if (!window->context.egl.client)
-        {
-            _glfwInputError(GLFW_API_UNAVAILABLE,
-                            "EGL: Failed to load client library");
-            return GLFW_FALSE;
-        }
-    }
+    if (!loadClientLibraryEGL(window, ctxconfig))
+        return GLFW_FALSE;
 
     window->context.makeCurrent = makeContextCurrentEGL;
     window->context.swapBuffers = swapBuffersEGL;
@@ -699,6 +884,7 @@ GLFWbool _glfwCreateContextEGL(_GLFWwindow* window,
     window->context.extensionSupported = extensionSupportedEGL;
     window->context.getProcAddress = getProcAddressEGL;
     window->context.destroy = destroyContextEGL;
+    window->context.createShared = createSharedContextEGL;
 
     return GLFW_TRUE;
 }
@@ -529,12 +529,26 @@ void _glfwPlatformPostEmptyEvent(void)
   // @TODO: Add Me!
 }
 
+void _glfwPlatformRequestPresentTime(_GLFWwindow* window)
+{
+}
+
+GLFWbool _glfwPlatformGetPresentTime(_GLFWwindow* window,
+                                     uint64_t* time, uint64_t* refresh)
+{
+  return GLFW_FALSE;
+}
+
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
 {
   *xpos = (double)window->ggp.mouse.xpos;
   *ypos = (double)window->ggp.mouse.ypos;
 }
 
+void _glfwPlatformSyncCursorPos(_GLFWwindow* window)
+{
+}
+
 void _glfwPlatformSetCursorPos(_GLFWwindow* window, double x, double y)
 {
   // @TODO: Add Me!
@@ -580,6 +594,17 @@ const char* _glfwPlatformGetClipboardString(void)
   return NULL;
 }
 
+void _glfwPlatformRequestClipboardString(void)
+{
+  _glfwInputClipboardString(_glfwPlatformGetClipboardString());
+}
+
+void _glfwPlatformSetClipboardData(const char* mime, void* data, size_t size,
+                                   GLFWclipboardfreefun callback)
+{
+  _glfwSetClipboardDataAsString(mime, data, size, callback);
+}
+
 const char* _glfwPlatformGetKeyName(int key, int scancode) { return ""; }
 
 int _glfwPlatformGetKeyScancode(int key) { return -1; }
@@ -592,11 +617,15 @@ void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
   extensions[1] = "VK_GGP_stream_descriptor_surface";
 }
 
-int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
-                                                      VkPhysicalDevice device,
-                                                      uint32_t queuefamily)
+uint32_t _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
+                                                           VkPhysicalDevice device,
+                                                           uint32_t first,
+                                                           uint32_t count)
 {
-  return GLFW_TRUE;
+  uint32_t i, mask = 0;
+  for (i = 0;  i < count;  i++)
+    mask |= 1u << i;
+  return mask;
 }
 
 VkResult _glfwPlatformCreateWindowSurface(
@@ -157,10 +157,15 @@ static GLXContext createLegacyContextGLX(_GLFWwindow* window,
 
 static void makeContextCurrentGLX(_GLFWwindow* window)
 {
+    _GLFW_COUNT(makeCurrents);
+
     if (window)
     {
+        const GLXDrawable drawable = window->context.pool ?
+            window->context.glx.pbuffer : window->context.glx.window;
+
         if (!glXMakeCurrent(_glfw.x11.display,
-                            window->context.glx.window,
+                            drawable,
                             window->context.glx.handle))
         {
             _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -236,6 +241,12 @@ static void destroyContextGLX(_GLFWwindow* window)
         window->context.glx.window = None;
     }
 
+    if (window->context.glx.pbuffer)
+    {
+        glXDestroyPbuffer(_glfw.x11.display, window->context.glx.pbuffer);
+        window->context.glx.pbuffer = None;
+    }
+
     if (window->context.glx.handle)
     {
         glXDestroyContext(_glfw.x11.display, window->context.glx.handle);
@@ -306,6 +317,10 @@ GLFWbool _glfwInitGLX(void)
         _glfw_dlsym(_glfw.glx.handle, "glXCreateWindow");
     _glfw.glx.DestroyWindow =
         _glfw_dlsym(_glfw.glx.handle, "glXDestroyWindow");
+    _glfw.glx.CreatePbuffer =
+        _glfw_dlsym(_glfw.glx.handle, "glXCreatePbuffer");
+    _glfw.glx.DestroyPbuffer =
+        _glfw_dlsym(_glfw.glx.handle, "glXDestroyPbuffer");
     _glfw.glx.GetProcAddress =
         _glfw_dlsym(_glfw.glx.handle, "glXGetProcAddress");
     _glfw.glx.GetProcAddressARB =
@@ -325,6 +340,8 @@ GLFWbool _glfwInitGLX(void)
         !_glfw.glx.CreateNewContext ||
         !_glfw.glx.CreateWindow ||
         !_glfw.glx.DestroyWindow ||
+        !_glfw.glx.CreatePbuffer ||
+        !_glfw.glx.DestroyPbuffer ||
         !_glfw.glx.GetProcAddress ||
         !_glfw.glx.GetProcAddressARB ||
         !_glfw.glx.GetVisualFromFBConfig)
@@ -365,6 +382,12 @@ GLFWbool _glfwInitGLX(void)
             _glfw.glx.EXT_swap_control = GLFW_TRUE;
     }
 
+    if (_glfw.glx.EXT_swap_control)
+    {
+        _glfw.glx.EXT_swap_control_tear =
+            extensionSupportedGLX("GLX_EXT_swap_control_tear");
+    }
+
     if (extensionSupportedGLX("GLX_SGI_swap_control"))
     {
         _glfw.glx.SwapIntervalSGI = (PFNGLXSWAPINTERVALSGIPROC)
@@ -383,6 +406,17 @@ GLFWbool _glfwInitGLX(void)
             _glfw.glx.MESA_swap_control = GLFW_TRUE;
     }
 
+    if (extensionSupportedGLX("GLX_OML_sync_control"))
+    {
+        _glfw.glx.GetSyncValuesOML = (PFNGLXGETSYNCVALUESOMLPROC)
+            getProcAddressGLX("glXGetSyncValuesOML");
+        _glfw.glx.GetMscRateOML = (PFNGLXGETMSCRATEOMLPROC)
+            getProcAddressGLX("glXGetMscRateOML");
+
+        if (_glfw.glx.GetSyncValuesOML && _glfw.glx.GetMscRateOML)
+            _glfw.glx.OML_sync_control = GLFW_TRUE;
+    }
+
     if (extensionSupportedGLX("GLX_ARB_multisample"))
         _glfw.glx.ARB_multisample = GLFW_TRUE;
 
@@ -440,26 +474,18 @@ void _glfwTerminateGLX(void)
     attribs[index++] = v; \
 }
 
-// Create the OpenGL or OpenGL ES context
+// Creates the OpenGL or OpenGL ES context for the specified GLXFBConfig
 //
-GLFWbool _glfwCreateContextGLX(_GLFWwindow* window,
-                               const _GLFWctxconfig* ctxconfig,
-                               const _GLFWfbconfig* fbconfig)
+static GLFWbool createContextGLX(_GLFWwindow* window,
+                                 const _GLFWctxconfig* ctxconfig,
+                                 GLXFBConfig native)
 {
     int attribs[40];
-    GLXFBConfig native = NULL;
     GLXContext share = NULL;
 
     if (ctxconfig->share)
         share = ctxconfig->share->context.glx.handle;
 
-    if (!chooseGLXFBConfig(fbconfig, &native))
-    {
-        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
-                        "GLX: Failed to find a suitable GLXFBConfig");
-        return GLFW_FALSE;
-    }
-
     if (ctxconfig->client == GLFW_OPENGL_ES_API)
     {
         if (!_glfw.glx.ARB_create_context ||
@@ -611,6 +637,63 @@ GLFWbool _glfwCreateContextGLX(_GLFWwindow* window,
         return GLFW_FALSE;
     }
 
+    window->context.glx.fbconfig = native;
+    return GLFW_TRUE;
+}
+
+// Creates a pooled context sharing objects with the specified window
+//
+static GLFWbool createSharedContextGLX(_GLFWwindow* context,
+                                       const _GLFWctxconfig* ctxconfig)
+{
+    const GLXFBConfig native = ctxconfig->share->context.glx.fbconfig;
+
+    if (!createContextGLX(context, ctxconfig, native))
+        return GLFW_FALSE;
+
+    // Without pbuffer support the context is made current without a drawable,
+    // which works for OpenGL 3.0 and later
+    if (getGLXFBConfigAttrib(native, GLX_DRAWABLE_TYPE) & GLX_PBUFFER_BIT)
+    {
+        const int attribs[] = { GLX_PBUFFER_WIDTH, 1, GLX_PBUFFER_HEIGHT, 1, None };
+
+        context->context.glx.pbuffer =
+            glXCreatePbuffer(_glfw.x11.display, native, attribs);
+        if (!context->context.glx.pbuffer)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "GLX: Failed to create pbuffer");
+            destroyContextGLX(context);
+            return GLFW_FALSE;
+        }
+    }
+
+    context->context.makeCurrent = makeContextCurrentGLX;
+    context->context.extensionSupported = extensionSupportedGLX;
+    context->context.getProcAddress = getProcAddressGLX;
+    context->context.destroy = destroyContextGLX;
+
+    return GLFW_TRUE;
+}
+
+// Create the OpenGL or OpenGL ES context
+//
+GLFWbool _glfwCreateContextGLX(_GLFWwindow* window,
+                               const _GLFWctxconfig* ctxconfig,
+                               const _GLFWfbconfig* fbconfig)
+{
+    GLXFBConfig native = NULL;
+
+    if (!chooseGLXFBConfig(fbconfig, &native))
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "GLX: Failed to find a suitable GLXFBConfig");
+        return GLFW_FALSE;
+    }
+
+    if (!createContextGLX(window, ctxconfig, native))
+        return GLFW_FALSE;
+
     window->context.glx.window =
         glXCreateWindow(_glfw.x11.display, native, window->x11.handle, NULL);
     if (!window->context.glx.window)
@@ -619,12 +702,15 @@ GLFWbool _glfwCreateContextGLX(_GLFWwindow* window,
         return GLFW_FALSE;
     }
 
+    window->context.swapTear = _glfw.glx.EXT_swap_control_tear;
+
     window->context.makeCurrent = makeContextCurrentGLX;
     window->context.swapBuffers = swapBuffersGLX;
     window->context.swapInterval = swapIntervalGLX;
     window->context.extensionSupported = extensionSupportedGLX;
     window->context.getProcAddress = getProcAddressGLX;
     window->context.destroy = destroyContextGLX;
+    window->context.createShared = createSharedContextGLX;
 
     return GLFW_TRUE;
 }
@@ -663,6 +749,57 @@ GLFWbool _glfwChooseVisualGLX(const _GLFWwndconfig* wndconfig,
     return GLFW_TRUE;
 }
 
+// Retrieves the presentation time of the most recent buffer swap and the
+// refresh period, in timer ticks
+//
+GLFWbool _glfwGetPresentTimeGLX(_GLFWwindow* window,
+                                uint64_t* time, uint64_t* refresh)
+{
+    int64_t ust, msc, sbc;
+    int32_t numerator, denominator;
+    uint64_t now;
+
+    // The UST is in microseconds and, on the implementations we know of, from
+    // the same clock as the monotonic timer
+    if (!_glfw.glx.OML_sync_control || !_glfw.timer.posix.monotonic)
+        return GLFW_FALSE;
+
+    if (!_glfw.glx.GetSyncValuesOML(_glfw.x11.display,
+                                    window->context.glx.window,
+                                    &ust, &msc, &sbc))
+    {
+        return GLFW_FALSE;
+    }
+
+    now = _glfwPlatformGetTimerValue();
+    if (ust <= 0 || (uint64_t) ust * 1000 > now)
+        return GLFW_FALSE;
+
+    // The UST is that of the most recent vertical blank, so a swap is
+    // attributed to the first one at which it is seen to have completed
+    if (sbc != window->context.glx.sbc)
+    {
+        window->context.glx.sbc = sbc;
+        window->context.glx.present = (uint64_t) ust * 1000;
+    }
+
+    if (!window->context.glx.present)
+        return GLFW_FALSE;
+
+    *time = window->context.glx.present;
+    *refresh = 0;
+
+    if (_glfw.glx.GetMscRateOML(_glfw.x11.display,
+                                window->context.glx.window,
+                                &numerator, &denominator))
+    {
+        if (numerator > 0 && denominator > 0)
+            *refresh = (uint64_t) denominator * 1000000000 / numerator;
+    }
+
+    return GLFW_TRUE;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                        GLFW native API                       //////
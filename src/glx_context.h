@@ -28,6 +28,9 @@
 #define GLX_VENDOR 1
 #define GLX_RGBA_BIT 0x00000001
 #define GLX_WINDOW_BIT 0x00000001
+#define GLX_PBUFFER_BIT 0x00000004
+#define GLX_PBUFFER_HEIGHT 0x8040
+#define GLX_PBUFFER_WIDTH 0x8041
 #define GLX_DRAWABLE_TYPE 0x8010
 #define GLX_RENDER_TYPE 0x8011
 #define GLX_RGBA_TYPE 0x8014
@@ -67,6 +70,7 @@
 #define GLX_CONTEXT_OPENGL_NO_ERROR_ARB 0x31b3
 
 typedef XID GLXWindow;
+typedef XID GLXPbuffer;
 typedef XID GLXDrawable;
 typedef struct __GLXFBConfig* GLXFBConfig;
 typedef struct __GLXcontext* GLXContext;
@@ -87,6 +91,11 @@ typedef void (*PFNGLXSWAPINTERVALEXTPROC)(Display*,GLXDrawable,int);
 typedef XVisualInfo* (*PFNGLXGETVISUALFROMFBCONFIGPROC)(Display*,GLXFBConfig);
 typedef GLXWindow (*PFNGLXCREATEWINDOWPROC)(Display*,GLXFBConfig,Window,const int*);
 typedef void (*PFNGLXDESTROYWINDOWPROC)(Display*,GLXWindow);
+typedef GLXPbuffer (*PFNGLXCREATEPBUFFERPROC)(Display*,GLXFBConfig,const int*);
+typedef void (*PFNGLXDESTROYPBUFFERPROC)(Display*,GLXPbuffer);
+
+typedef Bool (*PFNGLXGETSYNCVALUESOMLPROC)(Display*,GLXDrawable,int64_t*,int64_t*,int64_t*);
+typedef Bool (*PFNGLXGETMSCRATEOMLPROC)(Display*,GLXDrawable,int32_t*,int32_t*);
 
 typedef int (*PFNGLXSWAPINTERVALMESAPROC)(int);
 typedef int (*PFNGLXSWAPINTERVALSGIPROC)(int);
@@ -106,6 +115,8 @@ typedef GLXContext (*PFNGLXCREATECONTEXTATTRIBSARBPROC)(Display*,GLXFBConfig,GLX
 #define glXGetVisualFromFBConfig _glfw.glx.GetVisualFromFBConfig
 #define glXCreateWindow _glfw.glx.CreateWindow
 #define glXDestroyWindow _glfw.glx.DestroyWindow
+#define glXCreatePbuffer _glfw.glx.CreatePbuffer
+#define glXDestroyPbuffer _glfw.glx.DestroyPbuffer
 
 #define _GLFW_PLATFORM_CONTEXT_STATE            _GLFWcontextGLX glx
 #define _GLFW_PLATFORM_LIBRARY_CONTEXT_STATE    _GLFWlibraryGLX glx
@@ -116,7 +127,13 @@ typedef GLXContext (*PFNGLXCREATECONTEXTATTRIBSARBPROC)(Display*,GLXFBConfig,GLX
 typedef struct _GLFWcontextGLX
 {
     GLXContext      handle;
+    GLXFBConfig     fbconfig;
     GLXWindow       window;
+    // The drawable of a pooled shared context, if any
+    GLXPbuffer      pbuffer;
+    // Swap buffer count and presentation time of the most recent swap
+    int64_t         sbc;
+    uint64_t        present;
 
 } _GLFWcontextGLX;
 
@@ -145,6 +162,8 @@ typedef struct _GLFWlibraryGLX
     PFNGLXGETVISUALFROMFBCONFIGPROC     GetVisualFromFBConfig;
     PFNGLXCREATEWINDOWPROC              CreateWindow;
     PFNGLXDESTROYWINDOWPROC             DestroyWindow;
+    PFNGLXCREATEPBUFFERPROC             CreatePbuffer;
+    PFNGLXDESTROYPBUFFERPROC            DestroyPbuffer;
 
     // GLX 1.4 and extension functions
     PFNGLXGETPROCADDRESSPROC            GetProcAddress;
@@ -153,8 +172,11 @@ typedef struct _GLFWlibraryGLX
     PFNGLXSWAPINTERVALEXTPROC           SwapIntervalEXT;
     PFNGLXSWAPINTERVALMESAPROC          SwapIntervalMESA;
     PFNGLXCREATECONTEXTATTRIBSARBPROC   CreateContextAttribsARB;
+    PFNGLXGETSYNCVALUESOMLPROC          GetSyncValuesOML;
+    PFNGLXGETMSCRATEOMLPROC             GetMscRateOML;
     GLFWbool        SGI_swap_control;
     GLFWbool        EXT_swap_control;
+    GLFWbool        EXT_swap_control_tear;
     GLFWbool        MESA_swap_control;
     GLFWbool        ARB_multisample;
     GLFWbool        ARB_framebuffer_sRGB;
@@ -165,6 +187,7 @@ typedef struct _GLFWlibraryGLX
     GLFWbool        EXT_create_context_es2_profile;
     GLFWbool        ARB_create_context_no_error;
     GLFWbool        ARB_context_flush_control;
+    GLFWbool        OML_sync_control;
 
 } _GLFWlibraryGLX;
 
@@ -178,4 +201,6 @@ GLFWbool _glfwChooseVisualGLX(const _GLFWwndconfig* wndconfig,
                               const _GLFWctxconfig* ctxconfig,
                               const _GLFWfbconfig* fbconfig,
                               Visual** visual, int* depth);
+GLFWbool _glfwGetPresentTimeGLX(_GLFWwindow* window,
+                                uint64_t* time, uint64_t* refresh);
 
@@ -53,6 +53,7 @@ static GLFWerrorfun _glfwErrorCallback;
 static _GLFWinitconfig _glfwInitHints =
 {
     GLFW_TRUE,      // hat buttons
+    GLFW_FALSE,     // Vulkan loader prefetch
     {
         GLFW_TRUE,  // macOS menu bar
         GLFW_TRUE   // macOS bundle chdir
@@ -67,6 +68,9 @@ static void terminate(void)
 
     memset(&_glfw.callbacks, 0, sizeof(_glfw.callbacks));
 
+    if (_glfw.initialized)
+        _glfwTerminateTracing();
+
     while (_glfw.windowListHead)
         glfwDestroyWindow((GLFWwindow*) _glfw.windowListHead);
 
@@ -103,11 +107,48 @@ static void terminate(void)
 
     _glfwPlatformDestroyTls(&_glfw.contextSlot);
     _glfwPlatformDestroyTls(&_glfw.errorSlot);
+    _glfwPlatformDestroyTls(&_glfw.trace.slot);
     _glfwPlatformDestroyMutex(&_glfw.errorLock);
+    _glfwPlatformDestroyMutex(&_glfw.refreshLock);
+    _glfwPlatformDestroyMutex(&_glfw.trace.lock);
+    _glfwPlatformDestroyMutex(&_glfw.vk.lock);
+
+#if defined(_GLFW_CALL_COUNTS)
+    while (_glfw.callCounts.counterListHead)
+    {
+        _GLFWcallcounter* counter = _glfw.callCounts.counterListHead;
+        _glfw.callCounts.counterListHead = counter->next;
+        free(counter);
+    }
+
+    _glfwPlatformDestroyTls(&_glfw.callCounts.slot);
+    _glfwPlatformDestroyMutex(&_glfw.callCounts.lock);
+#endif
 
     memset(&_glfw, 0, sizeof(_glfw));
 }
 
+#if defined(_GLFW_CALL_COUNTS)
+// Sums the call counts of all threads
+// The call count lock must be held
+//
+static void sumCallCounts(GLFWcallcounts* sum)
+{
+    _GLFWcallcounter* counter;
+
+    memset(sum, 0, sizeof(GLFWcallcounts));
+
+    for (counter = _glfw.callCounts.counterListHead;  counter;  counter = counter->next)
+    {
+        sum->roundTrips   += counter->counts.roundTrips;
+        sum->deviceReads  += counter->counts.deviceReads;
+        sum->makeCurrents += counter->counts.makeCurrents;
+        sum->bufferSwaps  += counter->counts.bufferSwaps;
+        sum->shmMappings  += counter->counts.shmMappings;
+    }
+}
+#endif
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -145,6 +186,28 @@ float _glfw_fmaxf(float a, float b)
         return b;
 }
 
+#if defined(_GLFW_CALL_COUNTS)
+// Returns the call counts of the calling thread, creating them if necessary
+//
+_GLFWcallcounter* _glfwGetCallCounter(void)
+{
+    _GLFWcallcounter* counter = _glfwPlatformGetTls(&_glfw.callCounts.slot);
+    if (!counter)
+    {
+        counter = calloc(1, sizeof(_GLFWcallcounter));
+
+        _glfwPlatformLockMutex(&_glfw.callCounts.lock);
+        counter->next = _glfw.callCounts.counterListHead;
+        _glfw.callCounts.counterListHead = counter;
+        _glfwPlatformUnlockMutex(&_glfw.callCounts.lock);
+
+        _glfwPlatformSetTls(&_glfw.callCounts.slot, counter);
+    }
+
+    return counter;
+}
+#endif
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
@@ -231,6 +294,16 @@ GLFWAPI int glfwInit(void)
     memset(&_glfw, 0, sizeof(_glfw));
     _glfw.hints.init = _glfwInitHints;
 
+#if defined(_GLFW_CALL_COUNTS)
+    // Calls are counted from the start of platform initialization
+    if (!_glfwPlatformCreateMutex(&_glfw.callCounts.lock) ||
+        !_glfwPlatformCreateTls(&_glfw.callCounts.slot))
+    {
+        terminate();
+        return GLFW_FALSE;
+    }
+#endif
+
     if (!_glfwPlatformInit())
     {
         terminate();
@@ -238,8 +311,12 @@ GLFWAPI int glfwInit(void)
     }
 
     if (!_glfwPlatformCreateMutex(&_glfw.errorLock) ||
+        !_glfwPlatformCreateMutex(&_glfw.refreshLock) ||
+        !_glfwPlatformCreateMutex(&_glfw.vk.lock) ||
+        !_glfwPlatformCreateMutex(&_glfw.trace.lock) ||
         !_glfwPlatformCreateTls(&_glfw.errorSlot) ||
-        !_glfwPlatformCreateTls(&_glfw.contextSlot))
+        !_glfwPlatformCreateTls(&_glfw.contextSlot) ||
+        !_glfwPlatformCreateTls(&_glfw.trace.slot))
     {
         terminate();
         return GLFW_FALSE;
@@ -265,6 +342,15 @@ GLFWAPI int glfwInit(void)
         }
     }
 
+    if (_glfw.hints.init.vulkanPrefetch)
+    {
+        if (!_glfwPrefetchVulkan())
+        {
+            terminate();
+            return GLFW_FALSE;
+        }
+    }
+
     return GLFW_TRUE;
 }
 
@@ -283,6 +369,9 @@ GLFWAPI void glfwInitHint(int hint, int value)
         case GLFW_JOYSTICK_HAT_BUTTONS:
             _glfwInitHints.hatButtons = value;
             return;
+        case GLFW_VULKAN_LOADER_PREFETCH:
+            _glfwInitHints.vulkanPrefetch = value;
+            return;
         case GLFW_COCOA_CHDIR_RESOURCES:
             _glfwInitHints.ns.chdir = value;
             return;
@@ -340,3 +429,39 @@ GLFWAPI GLFWerrorfun glfwSetErrorCallback(GLFWerrorfun cbfun)
     return cbfun;
 }
 
+GLFWAPI int glfwGetCallCounts(GLFWcallcounts* counts)
+{
+    assert(counts != NULL);
+
+    memset(counts, 0, sizeof(GLFWcallcounts));
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+#if defined(_GLFW_CALL_COUNTS)
+    _glfwPlatformLockMutex(&_glfw.callCounts.lock);
+    sumCallCounts(counts);
+    counts->roundTrips   -= _glfw.callCounts.baseline.roundTrips;
+    counts->deviceReads  -= _glfw.callCounts.baseline.deviceReads;
+    counts->makeCurrents -= _glfw.callCounts.baseline.makeCurrents;
+    counts->bufferSwaps  -= _glfw.callCounts.baseline.bufferSwaps;
+    counts->shmMappings  -= _glfw.callCounts.baseline.shmMappings;
+    _glfwPlatformUnlockMutex(&_glfw.callCounts.lock);
+    return GLFW_TRUE;
+#else
+    return GLFW_FALSE;
+#endif
+}
+
+GLFWAPI void glfwResetCallCounts(void)
+{
+    _GLFW_REQUIRE_INIT();
+
+#if defined(_GLFW_CALL_COUNTS)
+    // The counts of other threads may be changing, so a reset only moves the
+    // baseline
+    _glfwPlatformLockMutex(&_glfw.callCounts.lock);
+    sumCallCounts(&_glfw.callCounts.baseline);
+    _glfwPlatformUnlockMutex(&_glfw.callCounts.lock);
+#endif
+}
+
@@ -252,6 +252,26 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
 }
 
 
+// Computes the FNV-1a hash of a custom cursor image and hotspot
+//
+static uint32_t hashCursorImage(const GLFWimage* image, int xhot, int yhot)
+{
+    const int header[] = { image->width, image->height, xhot, yhot };
+    const unsigned char* bytes = (const unsigned char*) header;
+    const size_t size = (size_t) image->width * image->height * 4;
+    uint32_t hash = 2166136261u;
+    size_t i;
+
+    for (i = 0;  i < sizeof(header);  i++)
+        hash = (hash ^ bytes[i]) * 16777619u;
+
+    for (i = 0;  i < size;  i++)
+        hash = (hash ^ image->pixels[i]) * 16777619u;
+
+    return hash;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
 //////////////////////////////////////////////////////////////////////////
@@ -283,7 +303,11 @@ void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int m
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
     if (window->callbacks.key)
+    {
+        _GLFW_TRACE_BEGIN("key callback");
         window->callbacks.key((GLFWwindow*) window, key, scancode, action, mods);
+        _GLFW_TRACE_END("key callback");
+    }
 }
 
 // Notifies shared code of a Unicode codepoint input event
@@ -298,12 +322,20 @@ void _glfwInputChar(_GLFWwindow* window, unsigned int codepoint, int mods, GLFWb
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
     if (window->callbacks.charmods)
+    {
+        _GLFW_TRACE_BEGIN("char mods callback");
         window->callbacks.charmods((GLFWwindow*) window, codepoint, mods);
+        _GLFW_TRACE_END("char mods callback");
+    }
 
     if (plain)
     {
         if (window->callbacks.character)
+        {
+            _GLFW_TRACE_BEGIN("char callback");
             window->callbacks.character((GLFWwindow*) window, codepoint);
+            _GLFW_TRACE_END("char callback");
+        }
     }
 }
 
@@ -312,7 +344,11 @@ void _glfwInputChar(_GLFWwindow* window, unsigned int codepoint, int mods, GLFWb
 void _glfwInputScroll(_GLFWwindow* window, double xoffset, double yoffset)
 {
     if (window->callbacks.scroll)
+    {
+        _GLFW_TRACE_BEGIN("scroll callback");
         window->callbacks.scroll((GLFWwindow*) window, xoffset, yoffset);
+        _GLFW_TRACE_END("scroll callback");
+    }
 }
 
 // Notifies shared code of a mouse button click event
@@ -331,7 +367,11 @@ void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods)
         window->mouseButtons[button] = (char) action;
 
     if (window->callbacks.mouseButton)
+    {
+        _GLFW_TRACE_BEGIN("mouse button callback");
         window->callbacks.mouseButton((GLFWwindow*) window, button, action, mods);
+        _GLFW_TRACE_END("mouse button callback");
+    }
 }
 
 // Notifies shared code of a cursor motion event
@@ -346,7 +386,11 @@ void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos)
     window->virtualCursorPosY = ypos;
 
     if (window->callbacks.cursorPos)
+    {
+        _GLFW_TRACE_BEGIN("cursor position callback");
         window->callbacks.cursorPos((GLFWwindow*) window, xpos, ypos);
+        _GLFW_TRACE_END("cursor position callback");
+    }
 }
 
 // Notifies shared code of a cursor enter/leave event
@@ -354,7 +398,11 @@ void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos)
 void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered)
 {
     if (window->callbacks.cursorEnter)
+    {
+        _GLFW_TRACE_BEGIN("cursor enter callback");
         window->callbacks.cursorEnter((GLFWwindow*) window, entered);
+        _GLFW_TRACE_END("cursor enter callback");
+    }
 }
 
 // Notifies shared code of files or directories dropped on a window
@@ -362,7 +410,42 @@ void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered)
 void _glfwInputDrop(_GLFWwindow* window, int count, const char** paths)
 {
     if (window->callbacks.drop)
+    {
+        _GLFW_TRACE_BEGIN("drop callback");
         window->callbacks.drop((GLFWwindow*) window, count, paths);
+        _GLFW_TRACE_END("drop callback");
+    }
+}
+
+// Notifies shared code that a clipboard transfer has completed
+// Every window with a pending request receives the same string
+//
+void _glfwInputClipboardString(const char* string)
+{
+    _GLFWwindow* window;
+
+    // Requests made from within a callback must wait for the next transfer
+    for (window = _glfw.windowListHead;  window;  window = window->next)
+    {
+        window->clipboardDelivery = window->callbacks.clipboard;
+        window->callbacks.clipboard = NULL;
+    }
+
+    window = _glfw.windowListHead;
+    while (window)
+    {
+        if (window->clipboardDelivery)
+        {
+            const GLFWclipboardfun callback = window->clipboardDelivery;
+            window->clipboardDelivery = NULL;
+            callback((GLFWwindow*) window, string);
+
+            // The callback may have destroyed any window, so start over
+            window = _glfw.windowListHead;
+        }
+        else
+            window = window->next;
+    }
 }
 
 // Notifies shared code of a joystick connection or disconnection
@@ -372,7 +455,11 @@ void _glfwInputJoystick(_GLFWjoystick* js, int event)
     const int jid = (int) (js - _glfw.joysticks);
 
     if (_glfw.callbacks.joystick)
+    {
+        _GLFW_TRACE_BEGIN("joystick callback");
         _glfw.callbacks.joystick(jid, event);
+        _GLFW_TRACE_END("joystick callback");
+    }
 }
 
 // Notifies shared code of the new value of a joystick axis
@@ -455,6 +542,30 @@ void _glfwFreeJoystick(_GLFWjoystick* js)
     memset(js, 0, sizeof(_GLFWjoystick));
 }
 
+// Sets the clipboard to a copy of text data, for platforms that cannot
+// reference the caller's memory
+//
+void _glfwSetClipboardDataAsString(const char* mime, void* data, size_t size,
+                                   GLFWclipboardfreefun callback)
+{
+    if (strcmp(mime, "text/plain;charset=utf-8") == 0 ||
+        strcmp(mime, "text/plain") == 0)
+    {
+        char* string = calloc(size + 1, 1);
+        memcpy(string, data, size);
+        _glfwPlatformSetClipboardString(string);
+        free(string);
+    }
+    else
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "Clipboard data of type %s is not supported", mime);
+    }
+
+    if (callback)
+        callback(data);
+}
+
 // Center the cursor in the content area of the specified window
 //
 void _glfwCenterCursorInContentArea(_GLFWwindow* window)
@@ -695,6 +806,22 @@ GLFWAPI void glfwGetCursorPos(GLFWwindow* handle, double* xpos, double* ypos)
         _glfwPlatformGetCursorPos(window, xpos, ypos);
 }
 
+GLFWAPI void glfwSyncCursorPos(GLFWwindow* handle, double* xpos, double* ypos)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (xpos)
+        *xpos = 0;
+    if (ypos)
+        *ypos = 0;
+
+    _GLFW_REQUIRE_INIT();
+
+    _glfwPlatformSyncCursorPos(window);
+    glfwGetCursorPos(handle, xpos, ypos);
+}
+
 GLFWAPI void glfwSetCursorPos(GLFWwindow* handle, double xpos, double ypos)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
@@ -730,12 +857,48 @@ GLFWAPI void glfwSetCursorPos(GLFWwindow* handle, double xpos, double ypos)
 GLFWAPI GLFWcursor* glfwCreateCursor(const GLFWimage* image, int xhot, int yhot)
 {
     _GLFWcursor* cursor;
+    _GLFWcursor* match;
+    size_t size;
+    uint32_t hash;
 
     assert(image != NULL);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
 
+    size = (size_t) image->width * image->height * 4;
+    hash = hashCursorImage(image, xhot, yhot);
+
+    // Share the native cursor of an existing identical custom cursor
+    for (match = _glfw.cursorListHead;  match;  match = match->next)
+    {
+        const _GLFWcursorimage* shared = match->image;
+
+        if (shared &&
+            shared->hash == hash &&
+            shared->width == image->width &&
+            shared->height == image->height &&
+            shared->xhot == xhot &&
+            shared->yhot == yhot &&
+            memcmp(shared->pixels, image->pixels, size) == 0)
+        {
+            break;
+        }
+    }
+
     cursor = calloc(1, sizeof(_GLFWcursor));
+
+    if (match)
+    {
+        // The new handle gets a copy of the platform state of the native
+        // cursor, which is destroyed with the last handle using it
+        *cursor = *match;
+        cursor->image->references++;
+
+        cursor->next = _glfw.cursorListHead;
+        _glfw.cursorListHead = cursor;
+        return (GLFWcursor*) cursor;
+    }
+
     cursor->next = _glfw.cursorListHead;
     _glfw.cursorListHead = cursor;
 
@@ -745,6 +908,16 @@ GLFWAPI GLFWcursor* glfwCreateCursor(const GLFWimage* image, int xhot, int yhot)
         return NULL;
     }
 
+    cursor->image = calloc(1, sizeof(_GLFWcursorimage));
+    cursor->image->references = 1;
+    cursor->image->hash = hash;
+    cursor->image->width = image->width;
+    cursor->image->height = image->height;
+    cursor->image->xhot = xhot;
+    cursor->image->yhot = yhot;
+    cursor->image->pixels = malloc(size);
+    memcpy(cursor->image->pixels, image->pixels, size);
+
     return (GLFWcursor*) cursor;
 }
 
@@ -802,7 +975,19 @@ GLFWAPI void glfwDestroyCursor(GLFWcursor* handle)
         }
     }
 
-    _glfwPlatformDestroyCursor(cursor);
+    // Other cursors with the same image keep the native cursor alive
+    if (cursor->image && --cursor->image->references > 0)
+        cursor->image = NULL;
+    else
+    {
+        _glfwPlatformDestroyCursor(cursor);
+
+        if (cursor->image)
+        {
+            free(cursor->image->pixels);
+            free(cursor->image);
+        }
+    }
 
     // Unlink cursor from global linked list
     {
@@ -1326,6 +1511,36 @@ GLFWAPI const char* glfwGetClipboardString(GLFWwindow* handle)
     return _glfwPlatformGetClipboardString();
 }
 
+GLFWAPI void glfwSetClipboardData(const char* mime, void* data, size_t size,
+                                  GLFWclipboardfreefun cbfun)
+{
+    assert(mime != NULL);
+    assert(data != NULL || size == 0);
+
+    if (!_glfw.initialized)
+    {
+        _glfwInputError(GLFW_NOT_INITIALIZED, NULL);
+        if (cbfun)
+            cbfun(data);
+        return;
+    }
+
+    _glfwPlatformSetClipboardData(mime, data, size, cbfun);
+}
+
+GLFWAPI void glfwRequestClipboardString(GLFWwindow* handle,
+                                        GLFWclipboardfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(cbfun != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    window->callbacks.clipboard = cbfun;
+    _glfwPlatformRequestClipboardString();
+}
+
 GLFWAPI double glfwGetTime(void)
 {
     _GLFW_REQUIRE_INIT_OR_RETURN(0.0);
@@ -57,6 +57,7 @@
 #define _GLFW_POLL_ALL          (_GLFW_POLL_AXES | _GLFW_POLL_BUTTONS)
 
 #define _GLFW_MESSAGE_SIZE      1024
+#define _GLFW_TRACE_BUFFER_SIZE 1024
 
 typedef int GLFWbool;
 
@@ -66,15 +67,21 @@ typedef struct _GLFWwndconfig   _GLFWwndconfig;
 typedef struct _GLFWctxconfig   _GLFWctxconfig;
 typedef struct _GLFWfbconfig    _GLFWfbconfig;
 typedef struct _GLFWcontext     _GLFWcontext;
+typedef struct _GLFWreadbackslot _GLFWreadbackslot;
 typedef struct _GLFWwindow      _GLFWwindow;
+typedef struct _GLFWcontextpool _GLFWcontextpool;
 typedef struct _GLFWlibrary     _GLFWlibrary;
 typedef struct _GLFWmonitor     _GLFWmonitor;
 typedef struct _GLFWcursor      _GLFWcursor;
+typedef struct _GLFWcursorimage _GLFWcursorimage;
 typedef struct _GLFWmapelement  _GLFWmapelement;
 typedef struct _GLFWmapping     _GLFWmapping;
 typedef struct _GLFWjoystick    _GLFWjoystick;
 typedef struct _GLFWtls         _GLFWtls;
 typedef struct _GLFWmutex       _GLFWmutex;
+typedef struct _GLFWthread      _GLFWthread;
+typedef struct _GLFWtracebuffer _GLFWtracebuffer;
+typedef struct _GLFWcallcounter _GLFWcallcounter;
 
 typedef void (* _GLFWmakecontextcurrentfun)(_GLFWwindow*);
 typedef void (* _GLFWswapbuffersfun)(_GLFWwindow*);
@@ -82,6 +89,10 @@ typedef void (* _GLFWswapintervalfun)(int);
 typedef int (* _GLFWextensionsupportedfun)(const char*);
 typedef GLFWglproc (* _GLFWgetprocaddressfun)(const char*);
 typedef void (* _GLFWdestroycontextfun)(_GLFWwindow*);
+typedef GLFWbool (* _GLFWmapframebufferfun)(_GLFWwindow*,GLFWframebufferdesc*);
+typedef void (* _GLFWunmapframebufferfun)(_GLFWwindow*);
+typedef GLFWbool (* _GLFWcreatesharedfun)(_GLFWwindow*,const _GLFWctxconfig*);
+typedef void (* _GLFWthreadfun)(void*);
 
 #define GL_VERSION 0x1f02
 #define GL_NONE 0
@@ -101,6 +112,20 @@ typedef void (* _GLFWdestroycontextfun)(_GLFWwindow*);
 #define GL_CONTEXT_RELEASE_BEHAVIOR 0x82fb
 #define GL_CONTEXT_RELEASE_BEHAVIOR_FLUSH 0x82fc
 #define GL_CONTEXT_FLAG_NO_ERROR_BIT_KHR 0x00000008
+#define GL_RGBA 0x1908
+#define GL_PACK_ROW_LENGTH 0x0d02
+#define GL_PACK_SKIP_ROWS 0x0d03
+#define GL_PACK_SKIP_PIXELS 0x0d04
+#define GL_PACK_ALIGNMENT 0x0d05
+#define GL_PIXEL_PACK_BUFFER 0x88eb
+#define GL_PIXEL_PACK_BUFFER_BINDING 0x88ed
+#define GL_STREAM_READ 0x88e1
+#define GL_READ_FRAMEBUFFER 0x8ca8
+#define GL_READ_FRAMEBUFFER_BINDING 0x8caa
+#define GL_MAP_READ_BIT 0x0001
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_ALREADY_SIGNALED 0x911a
+#define GL_CONDITION_SATISFIED 0x911c
 
 typedef int GLint;
 typedef unsigned int GLuint;
@@ -112,6 +137,19 @@ typedef void (APIENTRY * PFNGLCLEARPROC)(GLbitfield);
 typedef const GLubyte* (APIENTRY * PFNGLGETSTRINGPROC)(GLenum);
 typedef void (APIENTRY * PFNGLGETINTEGERVPROC)(GLenum,GLint*);
 typedef const GLubyte* (APIENTRY * PFNGLGETSTRINGIPROC)(GLenum,GLuint);
+typedef void (APIENTRY * PFNGLFINISHPROC)(void);
+typedef void (APIENTRY * PFNGLPIXELSTOREIPROC)(GLenum,GLint);
+typedef void (APIENTRY * PFNGLREADPIXELSPROC)(GLint,GLint,int,int,GLenum,GLenum,void*);
+typedef void (APIENTRY * PFNGLGENBUFFERSPROC)(int,GLuint*);
+typedef void (APIENTRY * PFNGLDELETEBUFFERSPROC)(int,const GLuint*);
+typedef void (APIENTRY * PFNGLBINDBUFFERPROC)(GLenum,GLuint);
+typedef void (APIENTRY * PFNGLBUFFERDATAPROC)(GLenum,ptrdiff_t,const void*,GLenum);
+typedef void* (APIENTRY * PFNGLMAPBUFFERRANGEPROC)(GLenum,ptrdiff_t,ptrdiff_t,GLbitfield);
+typedef unsigned char (APIENTRY * PFNGLUNMAPBUFFERPROC)(GLenum);
+typedef void (APIENTRY * PFNGLBINDFRAMEBUFFERPROC)(GLenum,GLuint);
+typedef void* (APIENTRY * PFNGLFENCESYNCPROC)(GLenum,GLbitfield);
+typedef GLenum (APIENTRY * PFNGLCLIENTWAITSYNCPROC)(void*,GLbitfield,uint64_t);
+typedef void (APIENTRY * PFNGLDELETESYNCPROC)(void*);
 
 #define VK_NULL_HANDLE 0
 
@@ -169,7 +207,10 @@ typedef struct VkExtensionProperties
     uint32_t        specVersion;
 } VkExtensionProperties;
 
+typedef struct VkQueueFamilyProperties VkQueueFamilyProperties;
+
 typedef void (APIENTRY * PFN_vkVoidFunction)(void);
+typedef void (APIENTRY * PFN_vkGetPhysicalDeviceQueueFamilyProperties)(VkPhysicalDevice,uint32_t*,VkQueueFamilyProperties*);
 
 #if defined(_GLFW_VULKAN_STATIC)
   PFN_vkVoidFunction vkGetInstanceProcAddr(VkInstance,const char*);
@@ -218,6 +259,30 @@ typedef void (APIENTRY * PFN_vkVoidFunction)(void);
         return x;                                    \
     }
 
+// Increments the specified member of the call counts, if enabled
+#if defined(_GLFW_CALL_COUNTS)
+ #define _GLFW_COUNT(member) (_glfwGetCallCounter()->counts.member++)
+#else
+ #define _GLFW_COUNT(member)
+#endif
+
+// Records a trace event, if tracing is enabled
+#define _GLFW_TRACE_BEGIN(name)                         \
+    do {                                                \
+        if (_glfw.trace.enabled)                        \
+            _glfwInputTrace(GLFW_TRACE_BEGIN, name);    \
+    } while (0)
+#define _GLFW_TRACE_END(name)                           \
+    do {                                                \
+        if (_glfw.trace.enabled)                        \
+            _glfwInputTrace(GLFW_TRACE_END, name);      \
+    } while (0)
+#define _GLFW_TRACE_INSTANT(name)                       \
+    do {                                                \
+        if (_glfw.trace.enabled)                        \
+            _glfwInputTrace(GLFW_TRACE_INSTANT, name);  \
+    } while (0)
+
 // Swaps the provided pointers
 #define _GLFW_SWAP_POINTERS(x, y) \
     {                             \
@@ -243,6 +308,7 @@ struct _GLFWerror
 struct _GLFWinitconfig
 {
     GLFWbool      hatButtons;
+    GLFWbool      vulkanPrefetch;
     struct {
         GLFWbool  menubar;
         GLFWbool  chdir;
@@ -301,6 +367,7 @@ struct _GLFWctxconfig
     int           profile;
     int           robustness;
     int           release;
+    int           readback;
     _GLFWwindow*  share;
     struct {
         GLFWbool  offline;
@@ -336,6 +403,20 @@ struct _GLFWfbconfig
     uintptr_t   handle;
 };
 
+// Framebuffer readback slot
+//
+// This holds one frame copied asynchronously into a pixel buffer object, along
+// with the fence that is signaled once the copy has completed.
+//
+struct _GLFWreadbackslot
+{
+    GLuint      buffer;
+    void*       sync;
+    int         width;
+    int         height;
+    uint64_t    frame;
+};
+
 // Context structure
 //
 struct _GLFWcontext
@@ -347,6 +428,7 @@ struct _GLFWcontext
     int                 profile;
     int                 robustness;
     int                 release;
+    GLFWbool            swapTear;
 
     PFNGLGETSTRINGIPROC GetStringi;
     PFNGLGETINTEGERVPROC GetIntegerv;
@@ -358,6 +440,35 @@ struct _GLFWcontext
     _GLFWextensionsupportedfun  extensionSupported;
     _GLFWgetprocaddressfun      getProcAddress;
     _GLFWdestroycontextfun      destroy;
+    _GLFWmapframebufferfun      mapFramebuffer;
+    _GLFWunmapframebufferfun    unmapFramebuffer;
+    _GLFWcreatesharedfun        createShared;
+
+    // The shared context pool owning this context, if any
+    _GLFWcontextpool*   pool;
+
+    // Number of buffer swaps so far
+    uint64_t            frames;
+
+    // Ring of pixel buffer objects receiving copies of presented frames
+    struct {
+        _GLFWreadbackslot*  slots;
+        int                 count;
+        int                 next;
+        int                 mapped;
+        PFNGLPIXELSTOREIPROC        PixelStorei;
+        PFNGLREADPIXELSPROC         ReadPixels;
+        PFNGLGENBUFFERSPROC         GenBuffers;
+        PFNGLDELETEBUFFERSPROC      DeleteBuffers;
+        PFNGLBINDBUFFERPROC         BindBuffer;
+        PFNGLBUFFERDATAPROC         BufferData;
+        PFNGLMAPBUFFERRANGEPROC     MapBufferRange;
+        PFNGLUNMAPBUFFERPROC        UnmapBuffer;
+        PFNGLBINDFRAMEBUFFERPROC    BindFramebuffer;
+        PFNGLFENCESYNCPROC          FenceSync;
+        PFNGLCLIENTWAITSYNCPROC     ClientWaitSync;
+        PFNGLDELETESYNCPROC         DeleteSync;
+    } readback;
 
     // This is defined in the context API's context.h
     _GLFW_PLATFORM_CONTEXT_STATE;
@@ -398,9 +509,18 @@ struct _GLFWwindow
     // Virtual cursor position when cursor is disabled
     double              virtualCursorPosX, virtualCursorPosY;
     GLFWbool            rawMouseMotion;
+    // Clipboard callback being called for the current transfer
+    GLFWclipboardfun    clipboardDelivery;
 
     _GLFWcontext        context;
 
+    // Frame pacing state, in timer ticks
+    struct {
+        uint64_t        swapped;
+        // Updated on the main thread and read under the refresh lock
+        uint64_t        refresh;
+    } timing;
+
     struct {
         GLFWwindowposfun        pos;
         GLFWwindowsizefun       size;
@@ -419,6 +539,7 @@ struct _GLFWwindow
         GLFWcharfun             character;
         GLFWcharmodsfun         charmods;
         GLFWdropfun             drop;
+        GLFWclipboardfun        clipboard;
     } callbacks;
 
     // This is defined in the window API's platform.h
@@ -449,12 +570,27 @@ struct _GLFWmonitor
     _GLFW_PLATFORM_MONITOR_STATE;
 };
 
+// Custom cursor image structure, shared by the cursors using the same native
+// cursor
+//
+struct _GLFWcursorimage
+{
+    int             references;
+    uint32_t        hash;
+    int             width, height;
+    int             xhot, yhot;
+    unsigned char*  pixels;
+};
+
 // Cursor structure
 //
 struct _GLFWcursor
 {
     _GLFWcursor*    next;
 
+    // The image of a custom cursor, for sharing its native cursor
+    _GLFWcursorimage* image;
+
     // This is defined in the window API's platform.h
     _GLFW_PLATFORM_CURSOR_STATE;
 };
@@ -515,6 +651,56 @@ struct _GLFWmutex
     _GLFW_PLATFORM_MUTEX_STATE;
 };
 
+// Thread structure
+//
+struct _GLFWthread
+{
+    _GLFWthreadfun      function;
+    void*               argument;
+
+    // This is defined in the platform's thread.h
+    _GLFW_PLATFORM_THREAD_STATE;
+};
+
+// Per-thread trace event buffer structure
+//
+struct _GLFWtracebuffer
+{
+    _GLFWtracebuffer*   next;
+    int                 thread;
+    int                 count;
+    struct {
+        const char*     name;
+        uint64_t        time;
+        int             type;
+    } events[_GLFW_TRACE_BUFFER_SIZE];
+};
+
+// Per-thread call count structure
+//
+struct _GLFWcallcounter
+{
+    _GLFWcallcounter*   next;
+    GLFWcallcounts      counts;
+};
+
+// Shared context pool structure
+//
+struct _GLFWcontextpool
+{
+    struct _GLFWcontextpool* next;
+
+    // The window whose context is shared by the pool
+    _GLFWwindow*        window;
+
+    // Context-only window objects and whether each is held by a thread
+    _GLFWwindow*        contexts;
+    GLFWbool*           acquired;
+    int                 count;
+
+    _GLFWmutex          lock;
+};
+
 // Library global data
 //
 struct _GLFWlibrary
@@ -532,6 +718,7 @@ struct _GLFWlibrary
     _GLFWerror*         errorListHead;
     _GLFWcursor*        cursorListHead;
     _GLFWwindow*        windowListHead;
+    _GLFWcontextpool*   contextPoolListHead;
 
     _GLFWmonitor**      monitors;
     int                 monitorCount;
@@ -543,6 +730,9 @@ struct _GLFWlibrary
     _GLFWtls            errorSlot;
     _GLFWtls            contextSlot;
     _GLFWmutex          errorLock;
+    // Guards the cached refresh periods of windows, as buffers may be swapped
+    // on any thread
+    _GLFWmutex          refreshLock;
 
     struct {
         uint64_t        offset;
@@ -554,6 +744,10 @@ struct _GLFWlibrary
         GLFWbool        available;
         void*           handle;
         char*           extensions[2];
+        _GLFWmutex      lock;
+        _GLFWthread     prefetch;
+        char            failure[_GLFW_MESSAGE_SIZE];
+        GLFWbool        unreported;
 #if !defined(_GLFW_VULKAN_STATIC)
         PFN_vkEnumerateInstanceExtensionProperties EnumerateInstanceExtensionProperties;
         PFN_vkGetInstanceProcAddr GetInstanceProcAddr;
@@ -581,6 +775,29 @@ struct _GLFWlibrary
         GLFWjoystickfun joystick;
     } callbacks;
 
+#if defined(_GLFW_CALL_COUNTS)
+    struct {
+        // Calls are counted per thread and summed when retrieved
+        _GLFWcallcounter* counterListHead;
+        // The sums at the last reset
+        GLFWcallcounts  baseline;
+        _GLFWtls        slot;
+        _GLFWmutex      lock;
+    } callCounts;
+#endif
+
+    struct {
+        GLFWbool        enabled;
+        GLFWtracefun    callback;
+        // The trace file is a FILE*
+        void*           file;
+        GLFWbool        empty;
+        int             threadCount;
+        _GLFWtracebuffer* bufferListHead;
+        _GLFWtls        slot;
+        _GLFWmutex      lock;
+    } trace;
+
     // This is defined in the window API's platform.h
     _GLFW_PLATFORM_LIBRARY_WINDOW_STATE;
     // This is defined in the context API's context.h
@@ -607,6 +824,7 @@ void _glfwPlatformTerminate(void);
 const char* _glfwPlatformGetVersionString(void);
 
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos);
+void _glfwPlatformSyncCursorPos(_GLFWwindow* window);
 void _glfwPlatformSetCursorPos(_GLFWwindow* window, double xpos, double ypos);
 void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode);
 void _glfwPlatformSetRawMouseMotion(_GLFWwindow *window, GLFWbool enabled);
@@ -632,6 +850,9 @@ void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
 
 void _glfwPlatformSetClipboardString(const char* string);
 const char* _glfwPlatformGetClipboardString(void);
+void _glfwPlatformRequestClipboardString(void);
+void _glfwPlatformSetClipboardData(const char* mime, void* data, size_t size,
+                                   GLFWclipboardfreefun callback);
 
 int _glfwPlatformPollJoystick(_GLFWjoystick* js, int mode);
 void _glfwPlatformUpdateGamepadGUID(char* guid);
@@ -688,10 +909,16 @@ void _glfwPlatformWaitEvents(void);
 void _glfwPlatformWaitEventsTimeout(double timeout);
 void _glfwPlatformPostEmptyEvent(void);
 
+void _glfwPlatformRequestPresentTime(_GLFWwindow* window);
+GLFWbool _glfwPlatformGetPresentTime(_GLFWwindow* window,
+                                     uint64_t* time, uint64_t* refresh);
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions);
-int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
-                                                      VkPhysicalDevice device,
-                                                      uint32_t queuefamily);
+// Returns a mask with bit i set if queue family first + i can present
+uint32_t _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
+                                                           VkPhysicalDevice device,
+                                                           uint32_t first,
+                                                           uint32_t count);
 VkResult _glfwPlatformCreateWindowSurface(VkInstance instance,
                                           _GLFWwindow* window,
                                           const VkAllocationCallbacks* allocator,
@@ -707,6 +934,11 @@ void _glfwPlatformDestroyMutex(_GLFWmutex* mutex);
 void _glfwPlatformLockMutex(_GLFWmutex* mutex);
 void _glfwPlatformUnlockMutex(_GLFWmutex* mutex);
 
+GLFWbool _glfwPlatformCreateThread(_GLFWthread* thread,
+                                   _GLFWthreadfun function,
+                                   void* argument);
+void _glfwPlatformJoinThread(_GLFWthread* thread);
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
@@ -723,6 +955,7 @@ void _glfwInputWindowMaximize(_GLFWwindow* window, GLFWbool maximized);
 void _glfwInputWindowDamage(_GLFWwindow* window);
 void _glfwInputWindowCloseRequest(_GLFWwindow* window);
 void _glfwInputWindowMonitor(_GLFWwindow* window, _GLFWmonitor* monitor);
+void _glfwInputRefreshChange(_GLFWwindow* window);
 
 void _glfwInputKey(_GLFWwindow* window,
                    int key, int scancode, int action, int mods);
@@ -733,6 +966,7 @@ void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods)
 void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos);
 void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered);
 void _glfwInputDrop(_GLFWwindow* window, int count, const char** names);
+void _glfwInputClipboardString(const char* string);
 void _glfwInputJoystick(_GLFWjoystick* js, int event);
 void _glfwInputJoystickAxis(_GLFWjoystick* js, int axis, float value);
 void _glfwInputJoystickButton(_GLFWjoystick* js, int button, char value);
@@ -741,6 +975,8 @@ void _glfwInputJoystickHat(_GLFWjoystick* js, int hat, char value);
 void _glfwInputMonitor(_GLFWmonitor* monitor, int action, int placement);
 void _glfwInputMonitorWindow(_GLFWmonitor* monitor, _GLFWwindow* window);
 
+void _glfwInputTrace(int type, const char* name);
+
 #if defined(__GNUC__)
 void _glfwInputError(int code, const char* format, ...)
     __attribute__((format(printf, 2, 3)));
@@ -760,6 +996,9 @@ const _GLFWfbconfig* _glfwChooseFBConfig(const _GLFWfbconfig* desired,
 GLFWbool _glfwRefreshContextAttribs(_GLFWwindow* window,
                                     const _GLFWctxconfig* ctxconfig);
 GLFWbool _glfwIsValidContextConfig(const _GLFWctxconfig* ctxconfig);
+void _glfwDestroyReadbackGL(_GLFWwindow* window);
+
+uint64_t _glfwGetRefreshPeriod(_GLFWwindow* window);
 
 const GLFWvidmode* _glfwChooseVideoMode(_GLFWmonitor* monitor,
                                         const GLFWvidmode* desired);
@@ -777,9 +1016,16 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
                                   int hatCount);
 void _glfwFreeJoystick(_GLFWjoystick* js);
 void _glfwCenterCursorInContentArea(_GLFWwindow* window);
+void _glfwSetClipboardDataAsString(const char* mime, void* data, size_t size,
+                                   GLFWclipboardfreefun callback);
 
 GLFWbool _glfwInitVulkan(int mode);
+GLFWbool _glfwPrefetchVulkan(void);
 void _glfwTerminateVulkan(void);
+void _glfwTerminateTracing(void);
+#if defined(_GLFW_CALL_COUNTS)
+_GLFWcallcounter* _glfwGetCallCounter(void);
+#endif
 const char* _glfwGetVulkanResultString(VkResult result);
 
 char* _glfw_strdup(const char* source);
@@ -395,6 +395,7 @@ int _glfwPlatformPollJoystick(_GLFWjoystick* js, int mode)
         struct input_event e;
 
         errno = 0;
+        _GLFW_COUNT(deviceReads);
         if (read(js->linjs.fd, &e, sizeof(e)) < 0)
         {
             // Reset the joystick slot if the device was disconnected
@@ -142,6 +142,9 @@ void _glfwInputMonitor(_GLFWmonitor* monitor, int action, int placement)
         }
     }
 
+    // The primary monitor may have changed
+    _glfwInputRefreshChange(NULL);
+
     if (_glfw.callbacks.monitor)
         _glfw.callbacks.monitor((GLFWmonitor*) monitor, action);
 
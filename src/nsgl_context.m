@@ -33,6 +33,8 @@
 
 static void makeContextCurrentNSGL(_GLFWwindow* window)
 {
+    _GLFW_COUNT(makeCurrents);
+
     @autoreleasepool {
 
     if (window)
@@ -123,6 +125,34 @@ static void destroyContextNSGL(_GLFWwindow* window)
     } // autoreleasepool
 }
 
+// Creates a pooled context sharing objects with the specified window
+//
+static GLFWbool createSharedContextNSGL(_GLFWwindow* context,
+                                        const _GLFWctxconfig* ctxconfig)
+{
+    _GLFWwindow* window = ctxconfig->share;
+
+    context->context.nsgl.pixelFormat = [window->context.nsgl.pixelFormat retain];
+    context->context.nsgl.object =
+        [[NSOpenGLContext alloc] initWithFormat:context->context.nsgl.pixelFormat
+                                   shareContext:window->context.nsgl.object];
+    if (context->context.nsgl.object == nil)
+    {
+        _glfwInputError(GLFW_VERSION_UNAVAILABLE,
+                        "NSGL: Failed to create OpenGL context");
+        [context->context.nsgl.pixelFormat release];
+        context->context.nsgl.pixelFormat = nil;
+        return GLFW_FALSE;
+    }
+
+    context->context.makeCurrent = makeContextCurrentNSGL;
+    context->context.extensionSupported = extensionSupportedNSGL;
+    context->context.getProcAddress = getProcAddressNSGL;
+    context->context.destroy = destroyContextNSGL;
+
+    return GLFW_TRUE;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -344,6 +374,7 @@ GLFWbool _glfwCreateContextNSGL(_GLFWwindow* window,
     window->context.extensionSupported = extensionSupportedNSGL;
     window->context.getProcAddress = getProcAddressNSGL;
     window->context.destroy = destroyContextNSGL;
+    window->context.createShared = createSharedContextNSGL;
 
     return GLFW_TRUE;
 }
@@ -42,11 +42,12 @@ int _glfwPlatformInit(void)
 
 void _glfwPlatformTerminate(void)
 {
+    _glfwTerminateEGL();
     _glfwTerminateOSMesa();
 }
 
 const char* _glfwPlatformGetVersionString(void)
 {
-    return _GLFW_VERSION_NUMBER " null OSMesa";
+    return _GLFW_VERSION_NUMBER " null OSMesa EGL";
 }
 
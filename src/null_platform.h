@@ -34,9 +34,12 @@
 #define _GLFW_PLATFORM_CURSOR_STATE          struct { int dummyCursor; }
 #define _GLFW_PLATFORM_LIBRARY_WINDOW_STATE  struct { int dummyLibraryWindow; }
 #define _GLFW_PLATFORM_LIBRARY_CONTEXT_STATE struct { int dummyLibraryContext; }
-#define _GLFW_EGL_CONTEXT_STATE              struct { int dummyEGLContext; }
-#define _GLFW_EGL_LIBRARY_CONTEXT_STATE      struct { int dummyEGLLibraryContext; }
 
+// EGL contexts on this platform are headless and need no native handles
+#define _GLFW_EGL_NATIVE_WINDOW  ((EGLNativeWindowType) NULL)
+#define _GLFW_EGL_NATIVE_DISPLAY EGL_DEFAULT_DISPLAY
+
+#include "egl_context.h"
 #include "osmesa_context.h"
 #include "posix_time.h"
 #include "posix_thread.h"
@@ -27,8 +27,12 @@
 // It is fine to use C99 in this file because it will not be built with VS
 //========================================================================
 
+#define _POSIX_C_SOURCE 199309L
+
 #include "internal.h"
 
+#include <time.h>
+
 
 static int createNativeWindow(_GLFWwindow* window,
                               const _GLFWwndconfig* wndconfig)
@@ -62,10 +66,12 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
             if (!_glfwCreateContextOSMesa(window, ctxconfig, fbconfig))
                 return GLFW_FALSE;
         }
-        else
+        else if (ctxconfig->source == GLFW_EGL_CONTEXT_API)
         {
-            _glfwInputError(GLFW_API_UNAVAILABLE, "Null: EGL not available");
-            return GLFW_FALSE;
+            if (!_glfwInitEGL())
+                return GLFW_FALSE;
+            if (!_glfwCreateContextEGL(window, ctxconfig, fbconfig))
+                return GLFW_FALSE;
         }
     }
 
@@ -253,16 +259,35 @@ void _glfwPlatformWaitEvents(void)
 
 void _glfwPlatformWaitEventsTimeout(double timeout)
 {
+    // There are no events, so only the timeout can end the wait
+    struct timespec ts;
+    ts.tv_sec = (time_t) timeout;
+    ts.tv_nsec = (long) ((timeout - (double) ts.tv_sec) * 1e9);
+    nanosleep(&ts, NULL);
 }
 
 void _glfwPlatformPostEmptyEvent(void)
 {
 }
 
+void _glfwPlatformRequestPresentTime(_GLFWwindow* window)
+{
+}
+
+GLFWbool _glfwPlatformGetPresentTime(_GLFWwindow* window,
+                                     uint64_t* time, uint64_t* refresh)
+{
+    return GLFW_FALSE;
+}
+
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
 {
 }
 
+void _glfwPlatformSyncCursorPos(_GLFWwindow* window)
+{
+}
+
 void _glfwPlatformSetCursorPos(_GLFWwindow* window, double x, double y)
 {
 }
@@ -300,6 +325,17 @@ const char* _glfwPlatformGetClipboardString(void)
     return NULL;
 }
 
+void _glfwPlatformRequestClipboardString(void)
+{
+    _glfwInputClipboardString(_glfwPlatformGetClipboardString());
+}
+
+void _glfwPlatformSetClipboardData(const char* mime, void* data, size_t size,
+                                   GLFWclipboardfreefun callback)
+{
+    _glfwSetClipboardDataAsString(mime, data, size, callback);
+}
+
 const char* _glfwPlatformGetScancodeName(int scancode)
 {
     return "";
@@ -314,11 +350,12 @@ void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
 }
 
-int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
-                                                      VkPhysicalDevice device,
-                                                      uint32_t queuefamily)
+uint32_t _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
+                                                           VkPhysicalDevice device,
+                                                           uint32_t first,
+                                                           uint32_t count)
 {
-    return GLFW_FALSE;
+    return 0;
 }
 
 VkResult _glfwPlatformCreateWindowSurface(VkInstance instance,
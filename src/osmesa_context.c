@@ -36,10 +36,17 @@
 
 static void makeContextCurrentOSMesa(_GLFWwindow* window)
 {
+    _GLFW_COUNT(makeCurrents);
+
     if (window)
     {
         int width, height;
-        _glfwPlatformGetFramebufferSize(window, &width, &height);
+
+        // Pooled contexts have no window and are bound to a single pixel
+        if (window->context.pool)
+            width = height = 1;
+        else
+            _glfwPlatformGetFramebufferSize(window, &width, &height);
 
         // Check to see if we need to allocate a new buffer
         if ((window->context.osmesa.buffer == NULL) ||
@@ -105,6 +112,30 @@ static int extensionSupportedOSMesa(const char* extension)
     return GLFW_FALSE;
 }
 
+static GLFWbool mapFramebufferOSMesa(_GLFWwindow* window,
+                                     GLFWframebufferdesc* desc)
+{
+    if (!window->context.osmesa.buffer)
+        return GLFW_FALSE;
+
+    // The color buffer is in system memory, so it only needs rendering to
+    // have finished
+    if (window == _glfwPlatformGetTls(&_glfw.contextSlot))
+    {
+        PFNGLFINISHPROC glFinish = (PFNGLFINISHPROC)
+            OSMesaGetProcAddress("glFinish");
+        if (glFinish)
+            glFinish();
+    }
+
+    desc->width = window->context.osmesa.width;
+    desc->height = window->context.osmesa.height;
+    desc->stride = window->context.osmesa.width * 4;
+    desc->frame = window->context.frames;
+    desc->pixels = window->context.osmesa.buffer;
+    return GLFW_TRUE;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -188,6 +219,18 @@ void _glfwTerminateOSMesa(void)
     }
 }
 
+// Creates a pooled context sharing objects with the specified window
+//
+static GLFWbool createSharedContextOSMesa(_GLFWwindow* context,
+                                          const _GLFWctxconfig* ctxconfig)
+{
+    _GLFWfbconfig fbconfig;
+
+    // Pooled contexts have no default framebuffer worth any ancillary buffers
+    memset(&fbconfig, 0, sizeof(fbconfig));
+    return _glfwCreateContextOSMesa(context, ctxconfig, &fbconfig);
+}
+
 #define setAttrib(a, v) \
 { \
     assert(((size_t) index + 1) < sizeof(attribs) / sizeof(attribs[0])); \
@@ -281,6 +324,8 @@ GLFWbool _glfwCreateContextOSMesa(_GLFWwindow* window,
     window->context.extensionSupported = extensionSupportedOSMesa;
     window->context.getProcAddress = getProcAddressOSMesa;
     window->context.destroy = destroyContextOSMesa;
+    window->context.mapFramebuffer = mapFramebufferOSMesa;
+    window->context.createShared = createSharedContextOSMesa;
 
     return GLFW_TRUE;
 }
@@ -0,0 +1,202 @@
+//========================================================================
+// GLFW 3.4 - www.glfw.org
+//------------------------------------------------------------------------
+// Copyright (c) 2006-2019 Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+// Please use C89 style variable declarations in this file because VS 2010
+//========================================================================
+
+#include "pixels.h"
+
+// The vector paths store the ARGB values as B, G, R, A bytes and so are only
+// used on little-endian targets, which all SSE2 targets are
+//
+// SSE2 is part of every x86-64 target, so needs no compiler flags.  Its
+// premultiply path is about twice as fast as the scalar loop at -O2 and as
+// fast at -O3, where GCC vectorizes that loop itself
+//
+#if defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define _GLFW_PIXELS_SSE2
+#elif defined(__ARM_NEON) && defined(__BYTE_ORDER__) && \
+      __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+ #include <arm_neon.h>
+ #define _GLFW_PIXELS_NEON
+#endif
+
+// All paths divide by 255 with truncation, exactly like the scalar path, as
+// (x + 1) * 257 >> 16 equals x / 255 for every product of two bytes
+//
+static uint32_t convertPixel(const unsigned char* source, int premultiply)
+{
+    const uint32_t alpha = source[3];
+
+    if (premultiply)
+    {
+        return (alpha << 24) |
+               (((source[0] * alpha) / 255) << 16) |
+               (((source[1] * alpha) / 255) <<  8) |
+               (((source[2] * alpha) / 255) <<  0);
+    }
+    else
+    {
+        return (alpha << 24) |
+               ((uint32_t) source[0] << 16) |
+               ((uint32_t) source[1] <<  8) |
+               ((uint32_t) source[2] <<  0);
+    }
+}
+
+#if defined(_GLFW_PIXELS_SSE2)
+
+// Converts four RGBA pixels to ARGB
+//
+static __m128i convertPixelsSSE2(__m128i pixels, int premultiply)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    __m128i halves[2];
+    int i;
+
+    halves[0] = _mm_unpacklo_epi8(pixels, zero);
+    halves[1] = _mm_unpackhi_epi8(pixels, zero);
+
+    for (i = 0;  i < 2;  i++)
+    {
+        __m128i color = halves[i];
+
+        if (premultiply)
+        {
+            __m128i alpha, product;
+
+            alpha = _mm_shufflelo_epi16(color, _MM_SHUFFLE(3, 3, 3, 3));
+            alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+
+            product = _mm_mullo_epi16(color, alpha);
+            product = _mm_add_epi16(product, _mm_set1_epi16(1));
+            product = _mm_mulhi_epu16(product, _mm_set1_epi16(257));
+
+            color = _mm_or_si128(_mm_andnot_si128(alphaMask, product),
+                                 _mm_and_si128(alphaMask, color));
+        }
+
+        color = _mm_shufflelo_epi16(color, _MM_SHUFFLE(3, 0, 1, 2));
+        halves[i] = _mm_shufflehi_epi16(color, _MM_SHUFFLE(3, 0, 1, 2));
+    }
+
+    return _mm_packus_epi16(halves[0], halves[1]);
+}
+
+#endif // _GLFW_PIXELS_SSE2
+
+#if defined(_GLFW_PIXELS_NEON)
+
+static uint8x16_t premultiplyNEON(uint8x16_t color, uint8x16_t alpha)
+{
+    const uint16x8_t one = vdupq_n_u16(1);
+    uint16x8_t low = vmull_u8(vget_low_u8(color), vget_low_u8(alpha));
+    uint16x8_t high = vmull_u8(vget_high_u8(color), vget_high_u8(alpha));
+
+    low = vaddq_u16(low, one);
+    high = vaddq_u16(high, one);
+
+    return vcombine_u8(vshrn_n_u16(vsraq_n_u16(low, low, 8), 8),
+                       vshrn_n_u16(vsraq_n_u16(high, high, 8), 8));
+}
+
+// Converts sixteen RGBA pixels to ARGB
+//
+static void convertPixelsNEON(uint32_t* target,
+                              const unsigned char* source,
+                              int premultiply)
+{
+    const uint8x16x4_t pixels = vld4q_u8(source);
+    uint8x16x4_t result;
+
+    if (premultiply)
+    {
+        result.val[0] = premultiplyNEON(pixels.val[2], pixels.val[3]);
+        result.val[1] = premultiplyNEON(pixels.val[1], pixels.val[3]);
+        result.val[2] = premultiplyNEON(pixels.val[0], pixels.val[3]);
+    }
+    else
+    {
+        result.val[0] = pixels.val[2];
+        result.val[1] = pixels.val[1];
+        result.val[2] = pixels.val[0];
+    }
+
+    result.val[3] = pixels.val[3];
+    vst4q_u8((uint8_t*) target, result);
+}
+
+#endif // _GLFW_PIXELS_NEON
+
+static void convertPixels(uint32_t* target,
+                          const unsigned char* source,
+                          size_t count,
+                          int premultiply)
+{
+    size_t i = 0;
+
+#if defined(_GLFW_PIXELS_SSE2)
+    for (;  i + 4 <= count;  i += 4)
+    {
+        const __m128i pixels = _mm_loadu_si128((const __m128i*) (source + i * 4));
+        _mm_storeu_si128((__m128i*) (target + i),
+                         convertPixelsSSE2(pixels, premultiply));
+    }
+#elif defined(_GLFW_PIXELS_NEON)
+    for (;  i + 16 <= count;  i += 16)
+        convertPixelsNEON(target + i, source + i * 4, premultiply);
+#endif
+
+    for (;  i < count;  i++)
+        target[i] = convertPixel(source + i * 4, premultiply);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Converts RGBA pixels to native-endian 32-bit ARGB values
+//
+void _glfwConvertPixelsARGB(uint32_t* target,
+                            const unsigned char* source,
+                            size_t count)
+{
+    convertPixels(target, source, count, 0);
+}
+
+// Converts RGBA pixels to native-endian 32-bit ARGB values with the color
+// channels premultiplied by alpha
+//
+void _glfwPremultiplyPixelsARGB(uint32_t* target,
+                                const unsigned char* source,
+                                size_t count)
+{
+    convertPixels(target, source, count, 1);
+}
+
@@ -32,11 +32,101 @@
 #include <assert.h>
 #include <string.h>
 
+// Calls the thread function with its argument
+//
+static void* threadMain(void* argument)
+{
+    _GLFWthread* thread = argument;
+    thread->function(thread->argument);
+    return NULL;
+}
+
+#if defined(_GLFW_THREAD_LOCAL)
+
+#define _GLFW_TLS_SLOT_COUNT 4
+
+// A compiler TLS slot, tagged with the generation of the TLS object that set
+// it, as values set before termination must not be seen after reinitialization
+//
+typedef struct _GLFWtlsSlotPOSIX
+{
+    void*           value;
+    unsigned int    generation;
+
+} _GLFWtlsSlotPOSIX;
+
+static _GLFW_THREAD_LOCAL _GLFWtlsSlotPOSIX tlsSlots[_GLFW_TLS_SLOT_COUNT];
+static GLFWbool tlsSlotsAllocated[_GLFW_TLS_SLOT_COUNT];
+static unsigned int tlsGeneration;
+
+#endif // _GLFW_THREAD_LOCAL
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
 //////////////////////////////////////////////////////////////////////////
 
+#if defined(_GLFW_THREAD_LOCAL)
+
+GLFWbool _glfwPlatformCreateTls(_GLFWtls* tls)
+{
+    int i;
+
+    assert(tls->posix.allocated == GLFW_FALSE);
+
+    for (i = 0;  i < _GLFW_TLS_SLOT_COUNT;  i++)
+    {
+        if (!tlsSlotsAllocated[i])
+            break;
+    }
+
+    if (i == _GLFW_TLS_SLOT_COUNT)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "POSIX: Failed to create context TLS");
+        return GLFW_FALSE;
+    }
+
+    tlsSlotsAllocated[i] = GLFW_TRUE;
+    tls->posix.index = i;
+    tls->posix.generation = ++tlsGeneration;
+    tls->posix.allocated = GLFW_TRUE;
+    return GLFW_TRUE;
+}
+
+void _glfwPlatformDestroyTls(_GLFWtls* tls)
+{
+    if (tls->posix.allocated)
+        tlsSlotsAllocated[tls->posix.index] = GLFW_FALSE;
+    memset(tls, 0, sizeof(_GLFWtls));
+}
+
+void* _glfwPlatformGetTls(_GLFWtls* tls)
+{
+    const _GLFWtlsSlotPOSIX* slot;
+
+    assert(tls->posix.allocated == GLFW_TRUE);
+
+    slot = tlsSlots + tls->posix.index;
+    if (slot->generation != tls->posix.generation)
+        return NULL;
+
+    return slot->value;
+}
+
+void _glfwPlatformSetTls(_GLFWtls* tls, void* value)
+{
+    _GLFWtlsSlotPOSIX* slot;
+
+    assert(tls->posix.allocated == GLFW_TRUE);
+
+    slot = tlsSlots + tls->posix.index;
+    slot->value = value;
+    slot->generation = tls->posix.generation;
+}
+
+#else // _GLFW_THREAD_LOCAL
+
 GLFWbool _glfwPlatformCreateTls(_GLFWtls* tls)
 {
     assert(tls->posix.allocated == GLFW_FALSE);
@@ -71,6 +161,8 @@ void _glfwPlatformSetTls(_GLFWtls* tls, void* value)
     pthread_setspecific(tls->posix.key, value);
 }
 
+#endif // _GLFW_THREAD_LOCAL
+
 GLFWbool _glfwPlatformCreateMutex(_GLFWmutex* mutex)
 {
     assert(mutex->posix.allocated == GLFW_FALSE);
@@ -103,3 +195,28 @@ void _glfwPlatformUnlockMutex(_GLFWmutex* mutex)
     pthread_mutex_unlock(&mutex->posix.handle);
 }
 
+GLFWbool _glfwPlatformCreateThread(_GLFWthread* thread,
+                                   _GLFWthreadfun function,
+                                   void* argument)
+{
+    assert(thread->posix.allocated == GLFW_FALSE);
+
+    thread->function = function;
+    thread->argument = argument;
+
+    if (pthread_create(&thread->posix.handle, NULL, threadMain, thread) != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR, "POSIX: Failed to create thread");
+        return GLFW_FALSE;
+    }
+
+    return thread->posix.allocated = GLFW_TRUE;
+}
+
+void _glfwPlatformJoinThread(_GLFWthread* thread)
+{
+    if (thread->posix.allocated)
+        pthread_join(thread->posix.handle, NULL);
+    memset(thread, 0, sizeof(_GLFWthread));
+}
+
@@ -29,6 +29,7 @@
 
 #define _GLFW_PLATFORM_TLS_STATE    _GLFWtlsPOSIX   posix
 #define _GLFW_PLATFORM_MUTEX_STATE  _GLFWmutexPOSIX posix
+#define _GLFW_PLATFORM_THREAD_STATE _GLFWthreadPOSIX posix
 
 
 // POSIX-specific thread local storage data
@@ -36,7 +37,12 @@
 typedef struct _GLFWtlsPOSIX
 {
     GLFWbool        allocated;
+#if defined(_GLFW_THREAD_LOCAL)
+    int             index;
+    unsigned int    generation;
+#else
     pthread_key_t   key;
+#endif
 
 } _GLFWtlsPOSIX;
 
@@ -49,3 +55,12 @@ typedef struct _GLFWmutexPOSIX
 
 } _GLFWmutexPOSIX;
 
+// POSIX-specific thread data
+//
+typedef struct _GLFWthreadPOSIX
+{
+    GLFWbool        allocated;
+    pthread_t       handle;
+
+} _GLFWthreadPOSIX;
+
@@ -0,0 +1,222 @@
+//========================================================================
+// GLFW 3.4 - www.glfw.org
+//------------------------------------------------------------------------
+// Copyright (c) 2006-2019 Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+// Please use C89 style variable declarations in this file because VS 2010
+//========================================================================
+
+#include "internal.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Updates whether trace events need to be recorded at all
+//
+static void updateEnabled(void)
+{
+    _glfw.trace.enabled = _glfw.trace.callback || _glfw.trace.file;
+}
+
+// Writes the events of the specified buffer to the trace file
+// The trace lock must be held
+//
+static void flushBuffer(_GLFWtracebuffer* buffer)
+{
+    int i;
+    FILE* file = _glfw.trace.file;
+    const double frequency = (double) _glfwPlatformGetTimerFrequency();
+
+    for (i = 0;  i < buffer->count;  i++)
+    {
+        const char* phase;
+
+        if (buffer->events[i].type == GLFW_TRACE_BEGIN)
+            phase = "\"B\"";
+        else if (buffer->events[i].type == GLFW_TRACE_END)
+            phase = "\"E\"";
+        else
+            phase = "\"i\",\"s\":\"t\"";
+
+        // The Chrome trace event format uses microseconds
+        fprintf(file, "%s{\"name\":\"%s\",\"ph\":%s,\"ts\":%.3f,\"pid\":1,\"tid\":%i}",
+                _glfw.trace.empty ? "" : ",\n",
+                buffer->events[i].name,
+                phase,
+                buffer->events[i].time * 1e6 / frequency,
+                buffer->thread);
+
+        _glfw.trace.empty = GLFW_FALSE;
+    }
+
+    buffer->count = 0;
+}
+
+// Returns the trace buffer of the calling thread, creating it if necessary
+//
+static _GLFWtracebuffer* getBuffer(void)
+{
+    _GLFWtracebuffer* buffer = _glfwPlatformGetTls(&_glfw.trace.slot);
+    if (!buffer)
+    {
+        buffer = calloc(1, sizeof(_GLFWtracebuffer));
+
+        _glfwPlatformLockMutex(&_glfw.trace.lock);
+        buffer->thread = ++_glfw.trace.threadCount;
+        buffer->next = _glfw.trace.bufferListHead;
+        _glfw.trace.bufferListHead = buffer;
+        _glfwPlatformUnlockMutex(&_glfw.trace.lock);
+
+        _glfwPlatformSetTls(&_glfw.trace.slot, buffer);
+    }
+
+    return buffer;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                         GLFW event API                       //////
+//////////////////////////////////////////////////////////////////////////
+
+// Notifies shared code of a trace event on the calling thread
+// The name must be a string literal, as it is kept until the trace is written
+//
+void _glfwInputTrace(int type, const char* name)
+{
+    const uint64_t time = _glfwPlatformGetTimerValue() - _glfw.timer.offset;
+
+    if (_glfw.trace.callback)
+        _glfw.trace.callback(type, name, time);
+
+    if (_glfw.trace.file)
+    {
+        _GLFWtracebuffer* buffer = getBuffer();
+
+        // Events are only written to the file once a buffer is full, so only
+        // then does a thread need the lock
+        if (buffer->count == _GLFW_TRACE_BUFFER_SIZE)
+        {
+            _glfwPlatformLockMutex(&_glfw.trace.lock);
+            if (_glfw.trace.file)
+                flushBuffer(buffer);
+            else
+                buffer->count = 0;
+            _glfwPlatformUnlockMutex(&_glfw.trace.lock);
+        }
+
+        buffer->events[buffer->count].name = name;
+        buffer->events[buffer->count].time = time;
+        buffer->events[buffer->count].type = type;
+        buffer->count++;
+    }
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Finishes any trace file and frees all trace buffers
+//
+void _glfwTerminateTracing(void)
+{
+    glfwStopTracing();
+
+    _glfw.trace.callback = NULL;
+    updateEnabled();
+
+    while (_glfw.trace.bufferListHead)
+    {
+        _GLFWtracebuffer* buffer = _glfw.trace.bufferListHead;
+        _glfw.trace.bufferListHead = buffer->next;
+        free(buffer);
+    }
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                        GLFW public API                       //////
+//////////////////////////////////////////////////////////////////////////
+
+GLFWAPI GLFWtracefun glfwSetTraceCallback(GLFWtracefun cbfun)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    _GLFW_SWAP_POINTERS(_glfw.trace.callback, cbfun);
+    updateEnabled();
+    return cbfun;
+}
+
+GLFWAPI int glfwStartTracing(const char* path)
+{
+    FILE* file;
+
+    assert(path != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    glfwStopTracing();
+
+    file = fopen(path, "w");
+    if (!file)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Failed to open trace file %s", path);
+        return GLFW_FALSE;
+    }
+
+    fputs("[\n", file);
+
+    _glfwPlatformLockMutex(&_glfw.trace.lock);
+    _glfw.trace.file = file;
+    _glfw.trace.empty = GLFW_TRUE;
+    _glfwPlatformUnlockMutex(&_glfw.trace.lock);
+
+    updateEnabled();
+    return GLFW_TRUE;
+}
+
+GLFWAPI void glfwStopTracing(void)
+{
+    _GLFWtracebuffer* buffer;
+
+    _GLFW_REQUIRE_INIT();
+
+    if (!_glfw.trace.file)
+        return;
+
+    _glfwPlatformLockMutex(&_glfw.trace.lock);
+
+    for (buffer = _glfw.trace.bufferListHead;  buffer;  buffer = buffer->next)
+        flushBuffer(buffer);
+
+    fputs("\n]\n", _glfw.trace.file);
+    fclose(_glfw.trace.file);
+    _glfw.trace.file = NULL;
+
+    _glfwPlatformUnlockMutex(&_glfw.trace.lock);
+
+    updateEnabled();
+}
+
@@ -32,16 +32,56 @@
 #include <assert.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
 
-#define _GLFW_FIND_LOADER    1
-#define _GLFW_REQUIRE_LOADER 2
+#define _GLFW_FIND_LOADER     1
+#define _GLFW_REQUIRE_LOADER  2
+#define _GLFW_PREFETCH_LOADER 3
 
 
-//////////////////////////////////////////////////////////////////////////
-//////                       GLFW internal API                      //////
-//////////////////////////////////////////////////////////////////////////
+// Unloads the Vulkan loader
+//
+static void unloadVulkan(void)
+{
+#if !defined(_GLFW_VULKAN_STATIC)
+    if (_glfw.vk.handle)
+    {
+        _glfw_dlclose(_glfw.vk.handle);
+        _glfw.vk.handle = NULL;
+    }
+#endif
+}
 
-GLFWbool _glfwInitVulkan(int mode)
+// Records why the Vulkan loader cannot be used, so that later calls can fail
+// without probing for it again, and reports it unless the failure is one that
+// is expected when Vulkan is merely being looked for
+//
+static GLFWbool loaderFailed(int mode, GLFWbool expected, const char* format, ...)
+{
+    va_list vl;
+
+    va_start(vl, format);
+    vsnprintf(_glfw.vk.failure, sizeof(_glfw.vk.failure), format, vl);
+    va_end(vl);
+
+    // The prefetch thread is not the application's, so the error is reported
+    // by the first call that asks about Vulkan on an application thread
+    if (mode == _GLFW_PREFETCH_LOADER)
+    {
+        if (!expected)
+            _glfw.vk.unreported = GLFW_TRUE;
+    }
+    else if (mode == _GLFW_REQUIRE_LOADER || !expected)
+        _glfwInputError(GLFW_API_UNAVAILABLE, "%s", _glfw.vk.failure);
+
+    unloadVulkan();
+    return GLFW_FALSE;
+}
+
+// Loads the Vulkan loader and enumerates its instance extensions
+//
+static GLFWbool initVulkan(int mode)
 {
     VkResult err;
     VkExtensionProperties* ep;
@@ -50,6 +90,18 @@ GLFWbool _glfwInitVulkan(int mode)
     if (_glfw.vk.available)
         return GLFW_TRUE;
 
+    if (_glfw.vk.failure[0])
+    {
+        if (mode == _GLFW_PREFETCH_LOADER)
+            return GLFW_FALSE;
+
+        if (mode == _GLFW_REQUIRE_LOADER || _glfw.vk.unreported)
+            _glfwInputError(GLFW_API_UNAVAILABLE, "%s", _glfw.vk.failure);
+
+        _glfw.vk.unreported = GLFW_FALSE;
+        return GLFW_FALSE;
+    }
+
 #if !defined(_GLFW_VULKAN_STATIC)
 #if defined(_GLFW_VULKAN_LIBRARY)
     _glfw.vk.handle = _glfw_dlopen(_GLFW_VULKAN_LIBRARY);
@@ -63,33 +115,22 @@ GLFWbool _glfwInitVulkan(int mode)
     _glfw.vk.handle = _glfw_dlopen("libvulkan.so.1");
 #endif
     if (!_glfw.vk.handle)
-    {
-        if (mode == _GLFW_REQUIRE_LOADER)
-            _glfwInputError(GLFW_API_UNAVAILABLE, "Vulkan: Loader not found");
-
-        return GLFW_FALSE;
-    }
+        return loaderFailed(mode, GLFW_TRUE, "Vulkan: Loader not found");
 
     _glfw.vk.GetInstanceProcAddr = (PFN_vkGetInstanceProcAddr)
         _glfw_dlsym(_glfw.vk.handle, "vkGetInstanceProcAddr");
     if (!_glfw.vk.GetInstanceProcAddr)
     {
-        _glfwInputError(GLFW_API_UNAVAILABLE,
-                        "Vulkan: Loader does not export vkGetInstanceProcAddr");
-
-        _glfwTerminateVulkan();
-        return GLFW_FALSE;
+        return loaderFailed(mode, GLFW_FALSE,
+                            "Vulkan: Loader does not export vkGetInstanceProcAddr");
     }
 
     _glfw.vk.EnumerateInstanceExtensionProperties = (PFN_vkEnumerateInstanceExtensionProperties)
         vkGetInstanceProcAddr(NULL, "vkEnumerateInstanceExtensionProperties");
     if (!_glfw.vk.EnumerateInstanceExtensionProperties)
     {
-        _glfwInputError(GLFW_API_UNAVAILABLE,
-                        "Vulkan: Failed to retrieve vkEnumerateInstanceExtensionProperties");
-
-        _glfwTerminateVulkan();
-        return GLFW_FALSE;
+        return loaderFailed(mode, GLFW_FALSE,
+                            "Vulkan: Failed to retrieve vkEnumerateInstanceExtensionProperties");
     }
 #endif // _GLFW_VULKAN_STATIC
 
@@ -97,15 +138,9 @@ GLFWbool _glfwInitVulkan(int mode)
     if (err)
     {
         // NOTE: This happens on systems with a loader but without any Vulkan ICD
-        if (mode == _GLFW_REQUIRE_LOADER)
-        {
-            _glfwInputError(GLFW_API_UNAVAILABLE,
+        return loaderFailed(mode, GLFW_TRUE,
                             "Vulkan: Failed to query instance extension count: %s",
                             _glfwGetVulkanResultString(err));
-        }
-
-        _glfwTerminateVulkan();
-        return GLFW_FALSE;
     }
 
     ep = calloc(count, sizeof(VkExtensionProperties));
@@ -113,13 +148,10 @@ GLFWbool _glfwInitVulkan(int mode)
     err = vkEnumerateInstanceExtensionProperties(NULL, &count, ep);
     if (err)
     {
-        _glfwInputError(GLFW_API_UNAVAILABLE,
-                        "Vulkan: Failed to query instance extensions: %s",
-                        _glfwGetVulkanResultString(err));
-
         free(ep);
-        _glfwTerminateVulkan();
-        return GLFW_FALSE;
+        return loaderFailed(mode, GLFW_FALSE,
+                            "Vulkan: Failed to query instance extensions: %s",
+                            _glfwGetVulkanResultString(err));
     }
 
     for (i = 0;  i < count;  i++)
@@ -160,12 +192,41 @@ GLFWbool _glfwInitVulkan(int mode)
     return GLFW_TRUE;
 }
 
+// Probes for the Vulkan loader on the prefetch thread
+//
+static void prefetchVulkan(void* argument)
+{
+    _glfwInitVulkan(_GLFW_PREFETCH_LOADER);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+GLFWbool _glfwInitVulkan(int mode)
+{
+    GLFWbool result;
+
+    _glfwPlatformLockMutex(&_glfw.vk.lock);
+    result = initVulkan(mode);
+    _glfwPlatformUnlockMutex(&_glfw.vk.lock);
+
+    return result;
+}
+
+// Starts probing for the Vulkan loader on a separate thread
+// Any Vulkan call made before the probe has finished waits for it
+//
+GLFWbool _glfwPrefetchVulkan(void)
+{
+    return _glfwPlatformCreateThread(&_glfw.vk.prefetch, prefetchVulkan, NULL);
+}
+
 void _glfwTerminateVulkan(void)
 {
-#if !defined(_GLFW_VULKAN_STATIC)
-    if (_glfw.vk.handle)
-        _glfw_dlclose(_glfw.vk.handle);
-#endif
+    _glfwPlatformJoinThread(&_glfw.vk.prefetch);
+    unloadVulkan();
 }
 
 const char* _glfwGetVulkanResultString(VkResult result)
@@ -299,7 +360,56 @@ GLFWAPI int glfwGetPhysicalDevicePresentationSupport(VkInstance instance,
 
     return _glfwPlatformGetPhysicalDevicePresentationSupport(instance,
                                                              device,
-                                                             queuefamily);
+                                                             queuefamily,
+                                                             1) != 0;
+}
+
+GLFWAPI int glfwGetPhysicalDevicePresentationSupportMask(VkInstance instance,
+                                                         VkPhysicalDevice device,
+                                                         uint32_t* mask)
+{
+    uint32_t count = 0;
+    PFN_vkGetPhysicalDeviceQueueFamilyProperties
+        vkGetPhysicalDeviceQueueFamilyProperties;
+
+    assert(instance != VK_NULL_HANDLE);
+    assert(device != VK_NULL_HANDLE);
+    assert(mask != NULL);
+
+    *mask = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!_glfwInitVulkan(_GLFW_REQUIRE_LOADER))
+        return GLFW_FALSE;
+
+    if (!_glfw.vk.extensions[0])
+    {
+        _glfwInputError(GLFW_API_UNAVAILABLE,
+                        "Vulkan: Window surface creation extensions not found");
+        return GLFW_FALSE;
+    }
+
+    vkGetPhysicalDeviceQueueFamilyProperties =
+        (PFN_vkGetPhysicalDeviceQueueFamilyProperties)
+        vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties");
+    if (!vkGetPhysicalDeviceQueueFamilyProperties)
+    {
+        _glfwInputError(GLFW_API_UNAVAILABLE,
+                        "Vulkan: Failed to retrieve vkGetPhysicalDeviceQueueFamilyProperties");
+        return GLFW_FALSE;
+    }
+
+    vkGetPhysicalDeviceQueueFamilyProperties(device, &count, NULL);
+    if (count > 32)
+        count = 32;
+
+    // The platform resolves its presentation support function once for all
+    // queue families
+    *mask = _glfwPlatformGetPhysicalDevicePresentationSupport(instance,
+                                                              device,
+                                                              0, count);
+    return *mask != 0;
 }
 
 GLFWAPI VkResult glfwCreateWindowSurface(VkInstance instance,
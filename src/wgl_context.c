@@ -294,6 +294,8 @@ static int choosePixelFormat(_GLFWwindow* window,
 
 static void makeContextCurrentWGL(_GLFWwindow* window)
 {
+    _GLFW_COUNT(makeCurrents);
+
     if (window)
     {
         if (wglMakeCurrent(window->context.wgl.dc, window->context.wgl.handle))
@@ -511,6 +513,8 @@ GLFWbool _glfwInitWGL(void)
         extensionSupportedWGL("WGL_ARB_create_context_no_error");
     _glfw.wgl.EXT_swap_control =
         extensionSupportedWGL("WGL_EXT_swap_control");
+    _glfw.wgl.EXT_swap_control_tear =
+        extensionSupportedWGL("WGL_EXT_swap_control_tear");
     _glfw.wgl.EXT_colorspace =
         extensionSupportedWGL("WGL_EXT_colorspace");
     _glfw.wgl.ARB_pixel_format =
@@ -538,47 +542,17 @@ void _glfwTerminateWGL(void)
     attribs[index++] = v; \
 }
 
-// Create the OpenGL or OpenGL ES context
+// Creates the OpenGL or OpenGL ES context for the pixel format of its DC
 //
-GLFWbool _glfwCreateContextWGL(_GLFWwindow* window,
-                               const _GLFWctxconfig* ctxconfig,
-                               const _GLFWfbconfig* fbconfig)
+static GLFWbool createContextWGL(_GLFWwindow* window,
+                                 const _GLFWctxconfig* ctxconfig)
 {
     int attribs[40];
-    int pixelFormat;
-    PIXELFORMATDESCRIPTOR pfd;
     HGLRC share = NULL;
 
     if (ctxconfig->share)
         share = ctxconfig->share->context.wgl.handle;
 
-    window->context.wgl.dc = GetDC(window->win32.handle);
-    if (!window->context.wgl.dc)
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "WGL: Failed to retrieve DC for window");
-        return GLFW_FALSE;
-    }
-
-    pixelFormat = choosePixelFormat(window, ctxconfig, fbconfig);
-    if (!pixelFormat)
-        return GLFW_FALSE;
-
-    if (!DescribePixelFormat(window->context.wgl.dc,
-                             pixelFormat, sizeof(pfd), &pfd))
-    {
-        _glfwInputErrorWin32(GLFW_PLATFORM_ERROR,
-                             "WGL: Failed to retrieve PFD for selected pixel format");
-        return GLFW_FALSE;
-    }
-
-    if (!SetPixelFormat(window->context.wgl.dc, pixelFormat, &pfd))
-    {
-        _glfwInputErrorWin32(GLFW_PLATFORM_ERROR,
-                             "WGL: Failed to set selected pixel format");
-        return GLFW_FALSE;
-    }
-
     if (ctxconfig->client == GLFW_OPENGL_API)
     {
         if (ctxconfig->forward)
@@ -763,12 +737,78 @@ GLFWbool _glfwCreateContextWGL(_GLFWwindow* window,
         }
     }
 
+    return GLFW_TRUE;
+}
+
+// Creates a pooled context sharing objects with the specified window
+//
+static GLFWbool createSharedContextWGL(_GLFWwindow* context,
+                                       const _GLFWctxconfig* ctxconfig)
+{
+    // A context can be made current on any DC with the pixel format it was
+    // created for, so pooled contexts use the DC of the window
+    context->context.wgl.dc = ctxconfig->share->context.wgl.dc;
+
+    if (!createContextWGL(context, ctxconfig))
+        return GLFW_FALSE;
+
+    context->context.makeCurrent = makeContextCurrentWGL;
+    context->context.extensionSupported = extensionSupportedWGL;
+    context->context.getProcAddress = getProcAddressWGL;
+    context->context.destroy = destroyContextWGL;
+
+    return GLFW_TRUE;
+}
+
+// Create the OpenGL or OpenGL ES context
+//
+GLFWbool _glfwCreateContextWGL(_GLFWwindow* window,
+                               const _GLFWctxconfig* ctxconfig,
+                               const _GLFWfbconfig* fbconfig)
+{
+    int pixelFormat;
+    PIXELFORMATDESCRIPTOR pfd;
+
+    window->context.wgl.dc = GetDC(window->win32.handle);
+    if (!window->context.wgl.dc)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "WGL: Failed to retrieve DC for window");
+        return GLFW_FALSE;
+    }
+
+    pixelFormat = choosePixelFormat(window, ctxconfig, fbconfig);
+    if (!pixelFormat)
+        return GLFW_FALSE;
+
+    if (!DescribePixelFormat(window->context.wgl.dc,
+                             pixelFormat, sizeof(pfd), &pfd))
+    {
+        _glfwInputErrorWin32(GLFW_PLATFORM_ERROR,
+                             "WGL: Failed to retrieve PFD for selected pixel format");
+        return GLFW_FALSE;
+    }
+
+    if (!SetPixelFormat(window->context.wgl.dc, pixelFormat, &pfd))
+    {
+        _glfwInputErrorWin32(GLFW_PLATFORM_ERROR,
+                             "WGL: Failed to set selected pixel format");
+        return GLFW_FALSE;
+    }
+
+    if (!createContextWGL(window, ctxconfig))
+        return GLFW_FALSE;
+
+    window->context.swapTear = _glfw.wgl.EXT_swap_control &&
+                               _glfw.wgl.EXT_swap_control_tear;
+
     window->context.makeCurrent = makeContextCurrentWGL;
     window->context.swapBuffers = swapBuffersWGL;
     window->context.swapInterval = swapIntervalWGL;
     window->context.extensionSupported = extensionSupportedWGL;
     window->context.getProcAddress = getProcAddressWGL;
     window->context.destroy = destroyContextWGL;
+    window->context.createShared = createSharedContextWGL;
 
     return GLFW_TRUE;
 }
@@ -137,6 +137,7 @@ typedef struct _GLFWlibraryWGL
     PFNWGLGETEXTENSIONSSTRINGARBPROC    GetExtensionsStringARB;
     PFNWGLCREATECONTEXTATTRIBSARBPROC   CreateContextAttribsARB;
     GLFWbool                            EXT_swap_control;
+    GLFWbool                            EXT_swap_control_tear;
     GLFWbool                            EXT_colorspace;
     GLFWbool                            ARB_multisample;
     GLFWbool                            ARB_framebuffer_sRGB;
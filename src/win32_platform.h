@@ -298,6 +298,7 @@ typedef VkBool32 (APIENTRY *PFN_vkGetPhysicalDeviceWin32PresentationSupportKHR)(
 #define _GLFW_PLATFORM_CURSOR_STATE         _GLFWcursorWin32  win32
 #define _GLFW_PLATFORM_TLS_STATE            _GLFWtlsWin32     win32
 #define _GLFW_PLATFORM_MUTEX_STATE          _GLFWmutexWin32   win32
+#define _GLFW_PLATFORM_THREAD_STATE         _GLFWthreadWin32  win32
 
 
 // Win32-specific per-window data
@@ -439,6 +440,15 @@ typedef struct _GLFWmutexWin32
 
 } _GLFWmutexWin32;
 
+// Win32-specific thread data
+//
+typedef struct _GLFWthreadWin32
+{
+    GLFWbool            allocated;
+    HANDLE              handle;
+
+} _GLFWthreadWin32;
+
 
 GLFWbool _glfwRegisterWindowClassWin32(void);
 void _glfwUnregisterWindowClassWin32(void);
@@ -32,6 +32,16 @@
 #include <assert.h>
 
 
+// Calls the thread function with its argument
+//
+static DWORD WINAPI threadMain(LPVOID argument)
+{
+    _GLFWthread* thread = argument;
+    thread->function(thread->argument);
+    return 0;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
 //////////////////////////////////////////////////////////////////////////
@@ -97,3 +107,33 @@ void _glfwPlatformUnlockMutex(_GLFWmutex* mutex)
     LeaveCriticalSection(&mutex->win32.section);
 }
 
+GLFWbool _glfwPlatformCreateThread(_GLFWthread* thread,
+                                   _GLFWthreadfun function,
+                                   void* argument)
+{
+    assert(thread->win32.allocated == GLFW_FALSE);
+
+    thread->function = function;
+    thread->argument = argument;
+
+    thread->win32.handle = CreateThread(NULL, 0, threadMain, thread, 0, NULL);
+    if (!thread->win32.handle)
+    {
+        _glfwInputErrorWin32(GLFW_PLATFORM_ERROR,
+                             "Win32: Failed to create thread");
+        return GLFW_FALSE;
+    }
+
+    return thread->win32.allocated = GLFW_TRUE;
+}
+
+void _glfwPlatformJoinThread(_GLFWthread* thread)
+{
+    if (thread->win32.allocated)
+    {
+        WaitForSingleObject(thread->win32.handle, INFINITE);
+        CloseHandle(thread->win32.handle);
+    }
+
+    memset(thread, 0, sizeof(_GLFWthread));
+}
@@ -526,6 +526,7 @@ static LRESULT CALLBACK windowProc(HWND hWnd, UINT uMsg,
 
             case WM_DISPLAYCHANGE:
                 _glfwPollMonitorsWin32();
+                _glfwInputRefreshChange(NULL);
                 break;
 
             case WM_DEVICECHANGE:
@@ -1985,6 +1986,16 @@ void _glfwPlatformPostEmptyEvent(void)
     PostMessage(_glfw.win32.helperWindowHandle, WM_NULL, 0, 0);
 }
 
+void _glfwPlatformRequestPresentTime(_GLFWwindow* window)
+{
+}
+
+GLFWbool _glfwPlatformGetPresentTime(_GLFWwindow* window,
+                                     uint64_t* time, uint64_t* refresh)
+{
+    return GLFW_FALSE;
+}
+
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
 {
     POINT pos;
@@ -2000,6 +2011,11 @@ void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
     }
 }
 
+void _glfwPlatformSyncCursorPos(_GLFWwindow* window)
+{
+    // The cursor position is always retrieved from the system
+}
+
 void _glfwPlatformSetCursorPos(_GLFWwindow* window, double xpos, double ypos)
 {
     POINT pos = { (int) xpos, (int) ypos };
@@ -2190,6 +2206,17 @@ const char* _glfwPlatformGetClipboardString(void)
     return _glfw.win32.clipboardString;
 }
 
+void _glfwPlatformRequestClipboardString(void)
+{
+    _glfwInputClipboardString(_glfwPlatformGetClipboardString());
+}
+
+void _glfwPlatformSetClipboardData(const char* mime, void* data, size_t size,
+                                   GLFWclipboardfreefun callback)
+{
+    _glfwSetClipboardDataAsString(mime, data, size, callback);
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (!_glfw.vk.KHR_surface || !_glfw.vk.KHR_win32_surface)
@@ -2199,10 +2226,12 @@ void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
     extensions[1] = "VK_KHR_win32_surface";
 }
 
-int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
-                                                      VkPhysicalDevice device,
-                                                      uint32_t queuefamily)
+uint32_t _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
+                                                           VkPhysicalDevice device,
+                                                           uint32_t first,
+                                                           uint32_t count)
 {
+    uint32_t i, mask = 0;
     PFN_vkGetPhysicalDeviceWin32PresentationSupportKHR
         vkGetPhysicalDeviceWin32PresentationSupportKHR =
         (PFN_vkGetPhysicalDeviceWin32PresentationSupportKHR)
@@ -2211,10 +2240,16 @@ int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
     {
         _glfwInputError(GLFW_API_UNAVAILABLE,
                         "Win32: Vulkan instance missing VK_KHR_win32_surface extension");
-        return GLFW_FALSE;
+        return 0;
+    }
+
+    for (i = 0;  i < count;  i++)
+    {
+        if (vkGetPhysicalDeviceWin32PresentationSupportKHR(device, first + i))
+            mask |= 1u << i;
     }
 
-    return vkGetPhysicalDeviceWin32PresentationSupportKHR(device, queuefamily);
+    return mask;
 }
 
 VkResult _glfwPlatformCreateWindowSurface(VkInstance instance,
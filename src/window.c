@@ -35,6 +35,39 @@
 #include <stdlib.h>
 #include <float.h>
 
+// Retrieves the frame timing of the window
+//
+static GLFWbool getFrameTiming(_GLFWwindow* window, GLFWframetiming* timing)
+{
+    uint64_t now;
+
+    memset(timing, 0, sizeof(GLFWframetiming));
+
+    if (_glfwPlatformGetPresentTime(window, &timing->present, &timing->refresh))
+        timing->exact = GLFW_TRUE;
+    else
+        timing->present = window->timing.swapped;
+
+    if (!timing->refresh)
+        timing->refresh = _glfwGetRefreshPeriod(window);
+
+    if (!timing->present || !timing->refresh)
+        return GLFW_FALSE;
+
+    // Vertical blanks are assumed to fall on a grid of refresh periods
+    // starting at the most recent presentation
+    now = _glfwPlatformGetTimerValue();
+    if (now < timing->present)
+        timing->next = timing->present;
+    else
+    {
+        timing->next = timing->present +
+            ((now - timing->present) / timing->refresh + 1) * timing->refresh;
+    }
+
+    return GLFW_TRUE;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
@@ -45,7 +78,11 @@
 void _glfwInputWindowFocus(_GLFWwindow* window, GLFWbool focused)
 {
     if (window->callbacks.focus)
+    {
+        _GLFW_TRACE_BEGIN("window focus callback");
         window->callbacks.focus((GLFWwindow*) window, focused);
+        _GLFW_TRACE_END("window focus callback");
+    }
 
     if (!focused)
     {
@@ -74,7 +111,11 @@ void _glfwInputWindowFocus(_GLFWwindow* window, GLFWbool focused)
 void _glfwInputWindowPos(_GLFWwindow* window, int x, int y)
 {
     if (window->callbacks.pos)
+    {
+        _GLFW_TRACE_BEGIN("window position callback");
         window->callbacks.pos((GLFWwindow*) window, x, y);
+        _GLFW_TRACE_END("window position callback");
+    }
 }
 
 // Notifies shared code that a window has been resized
@@ -83,7 +124,11 @@ void _glfwInputWindowPos(_GLFWwindow* window, int x, int y)
 void _glfwInputWindowSize(_GLFWwindow* window, int width, int height)
 {
     if (window->callbacks.size)
+    {
+        _GLFW_TRACE_BEGIN("window size callback");
         window->callbacks.size((GLFWwindow*) window, width, height);
+        _GLFW_TRACE_END("window size callback");
+    }
 }
 
 // Notifies shared code that a window has been iconified or restored
@@ -91,7 +136,11 @@ void _glfwInputWindowSize(_GLFWwindow* window, int width, int height)
 void _glfwInputWindowIconify(_GLFWwindow* window, GLFWbool iconified)
 {
     if (window->callbacks.iconify)
+    {
+        _GLFW_TRACE_BEGIN("window iconify callback");
         window->callbacks.iconify((GLFWwindow*) window, iconified);
+        _GLFW_TRACE_END("window iconify callback");
+    }
 }
 
 // Notifies shared code that a window has been maximized or restored
@@ -99,7 +148,11 @@ void _glfwInputWindowIconify(_GLFWwindow* window, GLFWbool iconified)
 void _glfwInputWindowMaximize(_GLFWwindow* window, GLFWbool maximized)
 {
     if (window->callbacks.maximize)
+    {
+        _GLFW_TRACE_BEGIN("window maximize callback");
         window->callbacks.maximize((GLFWwindow*) window, maximized);
+        _GLFW_TRACE_END("window maximize callback");
+    }
 }
 
 // Notifies shared code that a window framebuffer has been resized
@@ -108,7 +161,11 @@ void _glfwInputWindowMaximize(_GLFWwindow* window, GLFWbool maximized)
 void _glfwInputFramebufferSize(_GLFWwindow* window, int width, int height)
 {
     if (window->callbacks.fbsize)
+    {
+        _GLFW_TRACE_BEGIN("framebuffer size callback");
         window->callbacks.fbsize((GLFWwindow*) window, width, height);
+        _GLFW_TRACE_END("framebuffer size callback");
+    }
 }
 
 // Notifies shared code that a window content scale has changed
@@ -117,7 +174,11 @@ void _glfwInputFramebufferSize(_GLFWwindow* window, int width, int height)
 void _glfwInputWindowContentScale(_GLFWwindow* window, float xscale, float yscale)
 {
     if (window->callbacks.scale)
+    {
+        _GLFW_TRACE_BEGIN("window content scale callback");
         window->callbacks.scale((GLFWwindow*) window, xscale, yscale);
+        _GLFW_TRACE_END("window content scale callback");
+    }
 }
 
 // Notifies shared code that the window contents needs updating
@@ -125,7 +186,11 @@ void _glfwInputWindowContentScale(_GLFWwindow* window, float xscale, float yscal
 void _glfwInputWindowDamage(_GLFWwindow* window)
 {
     if (window->callbacks.refresh)
+    {
+        _GLFW_TRACE_BEGIN("window refresh callback");
         window->callbacks.refresh((GLFWwindow*) window);
+        _GLFW_TRACE_END("window refresh callback");
+    }
 }
 
 // Notifies shared code that the user wishes to close a window
@@ -135,7 +200,37 @@ void _glfwInputWindowCloseRequest(_GLFWwindow* window)
     window->shouldClose = GLFW_TRUE;
 
     if (window->callbacks.close)
+    {
+        _GLFW_TRACE_BEGIN("window close callback");
         window->callbacks.close((GLFWwindow*) window);
+        _GLFW_TRACE_END("window close callback");
+    }
+}
+
+// Looks up and caches the refresh period of the display of the window
+// Windowed mode windows use the primary monitor, as the window system does not
+// reliably tell which monitor is responsible for presenting a window
+// This queries the monitor, so must only be called on the main thread
+//
+static void updateRefreshPeriod(_GLFWwindow* window)
+{
+    GLFWvidmode mode;
+    uint64_t refresh = 0;
+    _GLFWmonitor* monitor = window->monitor;
+
+    if (!monitor && _glfw.monitorCount)
+        monitor = _glfw.monitors[0];
+
+    if (monitor)
+    {
+        _glfwPlatformGetVideoMode(monitor, &mode);
+        if (mode.refreshRate > 0)
+            refresh = _glfwPlatformGetTimerFrequency() / mode.refreshRate;
+    }
+
+    _glfwPlatformLockMutex(&_glfw.refreshLock);
+    window->timing.refresh = refresh;
+    _glfwPlatformUnlockMutex(&_glfw.refreshLock);
 }
 
 // Notifies shared code that a window has changed its desired monitor
@@ -143,8 +238,43 @@ void _glfwInputWindowCloseRequest(_GLFWwindow* window)
 void _glfwInputWindowMonitor(_GLFWwindow* window, _GLFWmonitor* monitor)
 {
     window->monitor = monitor;
+    updateRefreshPeriod(window);
 }
 
+// Notifies shared code that the refresh rate of a window or monitor may have
+// changed
+//
+void _glfwInputRefreshChange(_GLFWwindow* window)
+{
+    if (window)
+        updateRefreshPeriod(window);
+    else
+    {
+        for (window = _glfw.windowListHead;  window;  window = window->next)
+            updateRefreshPeriod(window);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Returns the cached refresh period of the display of the window, in timer
+// ticks, or zero if it is unknown
+// This may be called from any thread, as it does not query the monitor
+//
+uint64_t _glfwGetRefreshPeriod(_GLFWwindow* window)
+{
+    uint64_t refresh;
+
+    _glfwPlatformLockMutex(&_glfw.refreshLock);
+    refresh = window->timing.refresh;
+    _glfwPlatformUnlockMutex(&_glfw.refreshLock);
+
+    return refresh;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                        GLFW public API                       //////
 //////////////////////////////////////////////////////////////////////////
@@ -243,6 +373,8 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
         }
     }
 
+    updateRefreshPeriod(window);
+
     return (GLFWwindow*) window;
 }
 
@@ -408,6 +540,9 @@ GLFWAPI void glfwWindowHint(int hint, int value)
         case GLFW_CONTEXT_RELEASE_BEHAVIOR:
             _glfw.hints.context.release = value;
             return;
+        case GLFW_READBACK_BUFFERS:
+            _glfw.hints.context.readback = value;
+            return;
         case GLFW_REFRESH_RATE:
             _glfw.hints.refreshRate = value;
             return;
@@ -454,6 +589,24 @@ GLFWAPI void glfwDestroyWindow(GLFWwindow* handle)
     // Clear all callbacks to avoid exposing a half torn-down window object
     memset(&window->callbacks, 0, sizeof(window->callbacks));
 
+    if (window->context.readback.slots)
+        _glfwDestroyReadbackGL(window);
+
+    // Destroy any shared context pools of the window
+    {
+        _GLFWcontextpool* pool = _glfw.contextPoolListHead;
+
+        while (pool)
+        {
+            _GLFWcontextpool* next = pool->next;
+
+            if (pool->window == window)
+                glfwDestroySharedContextPool((GLFWcontextpool*) pool);
+
+            pool = next;
+        }
+    }
+
     // The window's context must not be current on another thread when the
     // window is destroyed
     if (window == _glfwPlatformGetTls(&_glfw.contextSlot))
@@ -854,6 +1007,8 @@ GLFWAPI int glfwGetWindowAttrib(GLFWwindow* handle, int attrib)
             return window->context.release;
         case GLFW_CONTEXT_NO_ERROR:
             return window->context.noerror;
+        case GLFW_CONTEXT_SWAP_TEAR:
+            return window->context.swapTear;
     }
 
     _glfwInputError(GLFW_INVALID_ENUM, "Invalid window attribute 0x%08X", attrib);
@@ -950,6 +1105,9 @@ GLFWAPI void glfwSetWindowMonitor(GLFWwindow* wh,
     _glfwPlatformSetWindowMonitor(window, monitor,
                                   xpos, ypos, width, height,
                                   refreshRate);
+
+    // The video mode of the monitor may have been changed
+    updateRefreshPeriod(window);
 }
 
 GLFWAPI void glfwSetWindowUserPointer(GLFWwindow* handle, void* pointer)
@@ -1069,16 +1227,57 @@ GLFWAPI GLFWwindowcontentscalefun glfwSetWindowContentScaleCallback(GLFWwindow*
     return cbfun;
 }
 
+GLFWAPI int glfwGetFrameTiming(GLFWwindow* handle, GLFWframetiming* timing)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(timing != NULL);
+
+    memset(timing, 0, sizeof(GLFWframetiming));
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+    return getFrameTiming(window, timing);
+}
+
+GLFWAPI void glfwWaitForNextFrame(GLFWwindow* handle)
+{
+    GLFWframetiming timing;
+    uint64_t now;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (!getFrameTiming(window, &timing))
+        return;
+
+    for (;;)
+    {
+        now = _glfwPlatformGetTimerValue();
+        if (now >= timing.next)
+            break;
+
+        _glfwPlatformWaitEventsTimeout((timing.next - now) /
+                                       (double) _glfwPlatformGetTimerFrequency());
+    }
+}
+
 GLFWAPI void glfwPollEvents(void)
 {
     _GLFW_REQUIRE_INIT();
+
+    _GLFW_TRACE_BEGIN("glfwPollEvents");
     _glfwPlatformPollEvents();
+    _GLFW_TRACE_END("glfwPollEvents");
 }
 
 GLFWAPI void glfwWaitEvents(void)
 {
     _GLFW_REQUIRE_INIT();
+
+    _GLFW_TRACE_BEGIN("glfwWaitEvents");
     _glfwPlatformWaitEvents();
+    _GLFW_TRACE_END("glfwWaitEvents");
 }
 
 GLFWAPI void glfwWaitEventsTimeout(double timeout)
@@ -1094,11 +1293,15 @@ GLFWAPI void glfwWaitEventsTimeout(double timeout)
         return;
     }
 
+    _GLFW_TRACE_BEGIN("glfwWaitEventsTimeout");
     _glfwPlatformWaitEventsTimeout(timeout);
+    _GLFW_TRACE_END("glfwWaitEventsTimeout");
 }
 
 GLFWAPI void glfwPostEmptyEvent(void)
 {
     _GLFW_REQUIRE_INIT();
+
+    _GLFW_TRACE_INSTANT("glfwPostEmptyEvent");
     _glfwPlatformPostEmptyEvent();
 }
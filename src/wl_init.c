@@ -780,6 +780,17 @@ static const struct xdg_wm_base_listener wmBaseListener = {
     wmBaseHandlePing
 };
 
+static void presentationHandleClockId(void* data,
+                                      struct wp_presentation* presentation,
+                                      uint32_t clockId)
+{
+    _glfw.wl.presentationClock = clockId;
+}
+
+static const struct wp_presentation_listener presentationListener = {
+    presentationHandleClockId
+};
+
 static void registryHandleGlobal(void* data,
                                  struct wl_registry* registry,
                                  uint32_t name,
@@ -845,6 +856,13 @@ static void registryHandleGlobal(void* data,
         _glfw.wl.viewporter =
             wl_registry_bind(registry, name, &wp_viewporter_interface, 1);
     }
+    else if (strcmp(interface, "wp_presentation") == 0)
+    {
+        _glfw.wl.presentation =
+            wl_registry_bind(registry, name, &wp_presentation_interface, 1);
+        wp_presentation_add_listener(_glfw.wl.presentation,
+                                     &presentationListener, NULL);
+    }
     else if (strcmp(interface, "zwp_relative_pointer_manager_v1") == 0)
     {
         _glfw.wl.relativePointerManager =
@@ -1119,6 +1137,9 @@ int _glfwPlatformInit(void)
         _glfw_dlsym(_glfw.wl.xkb.handle, "xkb_compose_state_get_one_sym");
 #endif
 
+    if (!_glfwPlatformCreateMutex(&_glfw.wl.presentationLock))
+        return GLFW_FALSE;
+
     _glfw.wl.display = wl_display_connect(NULL);
     if (!_glfw.wl.display)
     {
@@ -1141,9 +1162,11 @@ int _glfwPlatformInit(void)
     }
 
     // Sync so we got all registry objects
+    _GLFW_COUNT(roundTrips);
     wl_display_roundtrip(_glfw.wl.display);
 
     // Sync so we got all initial output events
+    _GLFW_COUNT(roundTrips);
     wl_display_roundtrip(_glfw.wl.display);
 
 #ifdef __linux__
@@ -1154,6 +1177,8 @@ int _glfwPlatformInit(void)
     _glfwInitTimerPOSIX();
 
     _glfw.wl.timerfd = -1;
+    _glfw.wl.clipboardRequest.fd = -1;
+    _glfw.wl.shmPool.fd = -1;
     if (_glfw.wl.seatVersion >= 4)
         _glfw.wl.timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
 
@@ -1255,6 +1280,7 @@ void _glfwPlatformTerminate(void)
         wl_subcompositor_destroy(_glfw.wl.subcompositor);
     if (_glfw.wl.compositor)
         wl_compositor_destroy(_glfw.wl.compositor);
+    _glfwTerminateShmPoolWayland();
     if (_glfw.wl.shm)
         wl_shm_destroy(_glfw.wl.shm);
     if (_glfw.wl.viewporter)
@@ -1283,6 +1309,9 @@ void _glfwPlatformTerminate(void)
         zwp_pointer_constraints_v1_destroy(_glfw.wl.pointerConstraints);
     if (_glfw.wl.idleInhibitManager)
         zwp_idle_inhibit_manager_v1_destroy(_glfw.wl.idleInhibitManager);
+    if (_glfw.wl.presentation)
+        wp_presentation_destroy(_glfw.wl.presentation);
+    _glfwPlatformDestroyMutex(&_glfw.wl.presentationLock);
     if (_glfw.wl.registry)
         wl_registry_destroy(_glfw.wl.registry);
     if (_glfw.wl.display)
@@ -1298,8 +1327,10 @@ void _glfwPlatformTerminate(void)
 
     if (_glfw.wl.clipboardString)
         free(_glfw.wl.clipboardString);
-    if (_glfw.wl.clipboardSendString)
-        free(_glfw.wl.clipboardSendString);
+    _glfwTerminateClipboardWayland();
+    if (_glfw.wl.clipboardRequest.fd >= 0)
+        close(_glfw.wl.clipboardRequest.fd);
+    free(_glfw.wl.clipboardRequest.data);
 }
 
 const char* _glfwPlatformGetVersionString(void)
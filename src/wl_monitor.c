@@ -81,7 +81,10 @@ static void outputHandleMode(void* data,
     monitor->modes[monitor->modeCount - 1] = mode;
 
     if (flags & WL_OUTPUT_MODE_CURRENT)
+    {
         monitor->wl.currentMode = monitor->modeCount - 1;
+        _glfwInputRefreshChange(NULL);
+    }
 }
 
 static void outputHandleDone(void* data, struct wl_output* output)
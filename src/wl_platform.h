@@ -53,12 +53,14 @@ typedef VkBool32 (APIENTRY *PFN_vkGetPhysicalDeviceWaylandPresentationSupportKHR
 #include "null_joystick.h"
 #endif
 #include "xkb_unicode.h"
+#include "pixels.h"
 #include "egl_context.h"
 #include "osmesa_context.h"
 
 #include "wayland-xdg-shell-client-protocol.h"
 #include "wayland-xdg-decoration-client-protocol.h"
 #include "wayland-viewporter-client-protocol.h"
+#include "wayland-presentation-time-client-protocol.h"
 #include "wayland-relative-pointer-unstable-v1-client-protocol.h"
 #include "wayland-pointer-constraints-unstable-v1-client-protocol.h"
 #include "wayland-idle-inhibit-unstable-v1-client-protocol.h"
@@ -151,6 +153,9 @@ typedef xkb_keysym_t (* PFN_xkb_compose_state_get_one_sym)(struct xkb_compose_st
 #define _GLFW_DECORATION_VERTICAL (_GLFW_DECORATION_TOP + _GLFW_DECORATION_WIDTH)
 #define _GLFW_DECORATION_HORIZONTAL (2 * _GLFW_DECORATION_WIDTH)
 
+// The number of frames in flight whose presentation time is tracked
+#define _GLFW_WL_PRESENTATION_FEEDBACKS 4
+
 typedef enum _GLFWdecorationSideWayland
 {
     mainWindow,
@@ -169,6 +174,51 @@ typedef struct _GLFWdecorationWayland
 
 } _GLFWdecorationWayland;
 
+// Wayland-specific buffer sub-allocated from the shared memory pool
+//
+typedef struct _GLFWshmBufferWayland
+{
+    struct _GLFWshmBufferWayland* next;
+    struct wl_buffer*           buffer;
+    size_t                      offset;
+    size_t                      size;
+    // The compositor may still read a buffer attached to a surface
+    GLFWbool                    busy;
+    GLFWbool                    destroyed;
+
+} _GLFWshmBufferWayland;
+
+// Wayland-specific free range of the shared memory pool
+//
+typedef struct _GLFWshmRangeWayland
+{
+    size_t                      offset;
+    size_t                      size;
+
+} _GLFWshmRangeWayland;
+
+// Wayland-specific clipboard data, shared by all pending writes of it
+//
+typedef struct _GLFWclipboardSourceWayland
+{
+    char*                       mimeType;
+    void*                       data;
+    size_t                      size;
+    GLFWclipboardfreefun        free;
+    int                         references;
+
+} _GLFWclipboardSourceWayland;
+
+// Wayland-specific unfinished clipboard write to another client
+//
+typedef struct _GLFWclipboardWriteWayland
+{
+    int                         fd;
+    size_t                      offset;
+    _GLFWclipboardSourceWayland* source;
+
+} _GLFWclipboardWriteWayland;
+
 // Wayland-specific per-window data
 //
 typedef struct _GLFWwindowWayland
@@ -207,6 +257,14 @@ typedef struct _GLFWwindowWayland
 
     struct zwp_idle_inhibitor_v1*          idleInhibitor;
 
+    struct {
+        // Feedback is only requested once presentation times have been asked for
+        GLFWbool                           wanted;
+        struct wp_presentation_feedback*   feedbacks[_GLFW_WL_PRESENTATION_FEEDBACKS];
+        uint64_t                           time;
+        uint64_t                           refresh;
+    } presentation;
+
     GLFWbool                    wasFullscreen;
 
     struct {
@@ -237,6 +295,10 @@ typedef struct _GLFWlibraryWayland
     struct xdg_wm_base*         wmBase;
     struct zxdg_decoration_manager_v1*      decorationManager;
     struct wp_viewporter*       viewporter;
+    struct wp_presentation*     presentation;
+    uint32_t                    presentationClock;
+    // Guards presentation feedback, as buffers may be swapped on any thread
+    _GLFWmutex                  presentationLock;
     struct zwp_relative_pointer_manager_v1* relativePointerManager;
     struct zwp_pointer_constraints_v1*      pointerConstraints;
     struct zwp_idle_inhibit_manager_v1*     idleInhibitManager;
@@ -257,9 +319,30 @@ typedef struct _GLFWlibraryWayland
     int                         keyboardLastScancode;
     char*                       clipboardString;
     size_t                      clipboardSize;
-    char*                       clipboardSendString;
-    size_t                      clipboardSendSize;
+    _GLFWclipboardSourceWayland* clipboardSource;
+    _GLFWclipboardWriteWayland* clipboardWrites;
+    int                         clipboardWriteCount;
     int                         timerfd;
+
+    // Shared memory for cursor and decoration buffers, grown as needed
+    struct {
+        struct wl_shm_pool*     pool;
+        int                     fd;
+        unsigned char*          data;
+        size_t                  size;
+        _GLFWshmRangeWayland*   ranges;
+        int                     rangeCount;
+        _GLFWshmBufferWayland*  buffers;
+    } shmPool;
+
+    // Asynchronous clipboard read (while a request is in progress)
+    struct {
+        int                     fd;
+        char*                   data;
+        size_t                  size;
+        size_t                  capacity;
+    } clipboardRequest;
+
     short int                   keycodes[256];
     short int                   scancodes[GLFW_KEY_LAST + 1];
 
@@ -354,4 +437,6 @@ typedef struct _GLFWcursorWayland
 
 
 void _glfwAddOutputWayland(uint32_t name, uint32_t version);
+void _glfwTerminateClipboardWayland(void);
+void _glfwTerminateShmPoolWayland(void);
 
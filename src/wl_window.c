@@ -38,7 +38,13 @@
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/timerfd.h>
+#include <time.h>
 #include <poll.h>
+#include <signal.h>
+#include <pthread.h>
+
+// The number of unfinished clipboard writes polled by each handleEvents call
+#define _GLFW_CLIPBOARD_WRITE_POLL_COUNT 16
 
 
 static int createTmpfileCloexec(char* tmpname)
@@ -52,6 +58,20 @@ static int createTmpfileCloexec(char* tmpname)
     return fd;
 }
 
+// Grows a file created by createAnonymousFile, returning zero or an error code
+//
+static int resizeAnonymousFile(int fd, off_t size)
+{
+#if defined(SHM_ANON)
+    // posix_fallocate does not work on SHM descriptors
+    if (ftruncate(fd, size) != 0)
+        return errno;
+    return 0;
+#else
+    return posix_fallocate(fd, 0, size);
+#endif
+}
+
 /*
  * Create a new, unique, anonymous file of the given size, and
  * return the file descriptor for it. The file descriptor is set
@@ -114,12 +134,7 @@ static int createAnonymousFile(off_t size)
             return -1;
     }
 
-#if defined(SHM_ANON)
-    // posix_fallocate does not work on SHM descriptors
-    ret = ftruncate(fd, size);
-#else
-    ret = posix_fallocate(fd, 0, size);
-#endif
+    ret = resizeAnonymousFile(fd, size);
     if (ret != 0)
     {
         close(fd);
@@ -129,57 +144,268 @@ static int createAnonymousFile(off_t size)
     return fd;
 }
 
-static struct wl_buffer* createShmBuffer(const GLFWimage* image)
+// Grows the shared memory pool by at least the specified number of bytes and
+// adds the new space to its free ranges
+//
+static GLFWbool growShmPool(size_t minimum)
 {
-    struct wl_shm_pool* pool;
-    struct wl_buffer* buffer;
-    int stride = image->width * 4;
-    int length = image->width * image->height * 4;
+    const size_t oldSize = _glfw.wl.shmPool.size;
+    size_t size = oldSize ? oldSize * 2 : 16384;
+    _GLFWshmRangeWayland* ranges;
     void* data;
-    int fd, i;
+    int ret;
 
-    fd = createAnonymousFile(length);
-    if (fd < 0)
+    while (size < oldSize + minimum)
+        size *= 2;
+
+    ranges = realloc(_glfw.wl.shmPool.ranges,
+                     sizeof(_GLFWshmRangeWayland) *
+                     (_glfw.wl.shmPool.rangeCount + 1));
+    if (!ranges)
     {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Creating a buffer file for %d B failed: %m",
-                        length);
-        return NULL;
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
+
+    _glfw.wl.shmPool.ranges = ranges;
+
+    if (_glfw.wl.shmPool.fd < 0)
+    {
+        _glfw.wl.shmPool.fd = createAnonymousFile(size);
+        if (_glfw.wl.shmPool.fd < 0)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Creating a buffer file for %zu B failed: %m",
+                            size);
+            return GLFW_FALSE;
+        }
+    }
+    else
+    {
+        ret = resizeAnonymousFile(_glfw.wl.shmPool.fd, size);
+        if (ret != 0)
+        {
+            errno = ret;
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Growing the buffer file to %zu B failed: %m",
+                            size);
+            return GLFW_FALSE;
+        }
     }
 
-    data = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                _glfw.wl.shmPool.fd, 0);
     if (data == MAP_FAILED)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
                         "Wayland: mmap failed: %m");
-        close(fd);
-        return NULL;
+        return GLFW_FALSE;
+    }
+
+    _GLFW_COUNT(shmMappings);
+
+    if (_glfw.wl.shmPool.data)
+        munmap(_glfw.wl.shmPool.data, oldSize);
+
+    _glfw.wl.shmPool.data = data;
+    _glfw.wl.shmPool.size = size;
+
+    if (_glfw.wl.shmPool.pool)
+        wl_shm_pool_resize(_glfw.wl.shmPool.pool, size);
+    else
+    {
+        _glfw.wl.shmPool.pool = wl_shm_create_pool(_glfw.wl.shm,
+                                                   _glfw.wl.shmPool.fd,
+                                                   size);
+    }
+
+    // Extend the last free range if it reaches the old end of the pool
+    if (_glfw.wl.shmPool.rangeCount)
+    {
+        _GLFWshmRangeWayland* last = ranges + _glfw.wl.shmPool.rangeCount - 1;
+        if (last->offset + last->size == oldSize)
+        {
+            last->size += size - oldSize;
+            return GLFW_TRUE;
+        }
+    }
+
+    ranges[_glfw.wl.shmPool.rangeCount].offset = oldSize;
+    ranges[_glfw.wl.shmPool.rangeCount].size = size - oldSize;
+    _glfw.wl.shmPool.rangeCount++;
+    return GLFW_TRUE;
+}
+
+// Allocates the specified number of bytes from the shared memory pool,
+// using the first free range large enough
+//
+static GLFWbool allocateShm(size_t size, size_t* offset)
+{
+    int i;
+
+    for (;;)
+    {
+        for (i = 0;  i < _glfw.wl.shmPool.rangeCount;  i++)
+        {
+            _GLFWshmRangeWayland* range = _glfw.wl.shmPool.ranges + i;
+            if (range->size < size)
+                continue;
+
+            *offset = range->offset;
+            range->offset += size;
+            range->size -= size;
+
+            if (range->size == 0)
+            {
+                _glfw.wl.shmPool.rangeCount--;
+                memmove(range, range + 1,
+                        sizeof(_GLFWshmRangeWayland) *
+                        (_glfw.wl.shmPool.rangeCount - i));
+            }
+
+            return GLFW_TRUE;
+        }
+
+        if (!growShmPool(size))
+            return GLFW_FALSE;
     }
+}
+
+// Returns the specified bytes to the shared memory pool, merging them with
+// adjacent free ranges
+//
+static void releaseShm(size_t offset, size_t size)
+{
+    _GLFWshmRangeWayland* ranges;
+    int i, count = _glfw.wl.shmPool.rangeCount;
 
-    pool = wl_shm_create_pool(_glfw.wl.shm, fd, length);
+    for (i = 0;  i < count;  i++)
+    {
+        if (_glfw.wl.shmPool.ranges[i].offset > offset)
+            break;
+    }
 
-    close(fd);
-    unsigned char* source = (unsigned char*) image->pixels;
-    unsigned char* target = data;
-    for (i = 0;  i < image->width * image->height;  i++, source += 4)
+    if (i > 0)
     {
-        unsigned int alpha = source[3];
+        _GLFWshmRangeWayland* prev = _glfw.wl.shmPool.ranges + i - 1;
+        if (prev->offset + prev->size == offset)
+        {
+            prev->size += size;
 
-        *target++ = (unsigned char) ((source[2] * alpha) / 255);
-        *target++ = (unsigned char) ((source[1] * alpha) / 255);
-        *target++ = (unsigned char) ((source[0] * alpha) / 255);
-        *target++ = (unsigned char) alpha;
+            if (i < count && prev->offset + prev->size ==
+                             _glfw.wl.shmPool.ranges[i].offset)
+            {
+                prev->size += _glfw.wl.shmPool.ranges[i].size;
+                _glfw.wl.shmPool.rangeCount--;
+                memmove(prev + 1, prev + 2,
+                        sizeof(_GLFWshmRangeWayland) * (count - i - 1));
+            }
+
+            return;
+        }
+    }
+
+    if (i < count && offset + size == _glfw.wl.shmPool.ranges[i].offset)
+    {
+        _glfw.wl.shmPool.ranges[i].offset = offset;
+        _glfw.wl.shmPool.ranges[i].size += size;
+        return;
+    }
+
+    ranges = realloc(_glfw.wl.shmPool.ranges,
+                     sizeof(_GLFWshmRangeWayland) * (count + 1));
+    if (!ranges)
+    {
+        // The space is lost until termination, which is better than reusing
+        // it while it may still be in use
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return;
     }
 
-    buffer =
-        wl_shm_pool_create_buffer(pool, 0,
+    memmove(ranges + i + 1, ranges + i,
+            sizeof(_GLFWshmRangeWayland) * (count - i));
+    ranges[i].offset = offset;
+    ranges[i].size = size;
+    _glfw.wl.shmPool.ranges = ranges;
+    _glfw.wl.shmPool.rangeCount++;
+}
+
+static void freeShmBuffer(_GLFWshmBufferWayland* buffer)
+{
+    _GLFWshmBufferWayland** prev = &_glfw.wl.shmPool.buffers;
+
+    while (*prev != buffer)
+        prev = &((*prev)->next);
+
+    *prev = buffer->next;
+
+    wl_buffer_destroy(buffer->buffer);
+    releaseShm(buffer->offset, buffer->size);
+    free(buffer);
+}
+
+static void bufferHandleRelease(void* data, struct wl_buffer* wlBuffer)
+{
+    _GLFWshmBufferWayland* buffer = data;
+
+    buffer->busy = GLFW_FALSE;
+    if (buffer->destroyed)
+        freeShmBuffer(buffer);
+}
+
+static const struct wl_buffer_listener bufferListener = {
+    bufferHandleRelease
+};
+
+static struct wl_buffer* createShmBuffer(const GLFWimage* image)
+{
+    _GLFWshmBufferWayland* buffer;
+    const int stride = image->width * 4;
+    // Keep every buffer cache line aligned for the pixel conversion
+    const size_t size = ((size_t) stride * image->height + 63) & ~(size_t) 63;
+    size_t offset;
+
+    if (!allocateShm(size, &offset))
+        return NULL;
+
+    _glfwPremultiplyPixelsARGB((uint32_t*) (_glfw.wl.shmPool.data + offset),
+                               image->pixels,
+                               (size_t) image->width * image->height);
+
+    buffer = calloc(1, sizeof(_GLFWshmBufferWayland));
+    buffer->offset = offset;
+    buffer->size = size;
+    buffer->buffer =
+        wl_shm_pool_create_buffer(_glfw.wl.shmPool.pool, (int32_t) offset,
                                   image->width,
                                   image->height,
                                   stride, WL_SHM_FORMAT_ARGB8888);
-    munmap(data, length);
-    wl_shm_pool_destroy(pool);
+    wl_buffer_add_listener(buffer->buffer, &bufferListener, buffer);
+
+    buffer->next = _glfw.wl.shmPool.buffers;
+    _glfw.wl.shmPool.buffers = buffer;
+
+    return buffer->buffer;
+}
 
-    return buffer;
+// Marks a buffer from createShmBuffer as attached to a surface
+//
+static void attachShmBuffer(struct wl_buffer* wlBuffer)
+{
+    _GLFWshmBufferWayland* buffer = wl_buffer_get_user_data(wlBuffer);
+    buffer->busy = GLFW_TRUE;
+}
+
+// Destroys a buffer from createShmBuffer once the compositor has released it,
+// as its memory may not be reused before then
+//
+static void destroyShmBuffer(struct wl_buffer* wlBuffer)
+{
+    _GLFWshmBufferWayland* buffer = wl_buffer_get_user_data(wlBuffer);
+
+    buffer->destroyed = GLFW_TRUE;
+    if (!buffer->busy)
+        freeShmBuffer(buffer);
 }
 
 static void createDecoration(_GLFWdecorationWayland* decoration,
@@ -199,6 +425,7 @@ static void createDecoration(_GLFWdecorationWayland* decoration,
                                                       decoration->surface);
     wp_viewport_set_destination(decoration->viewport, width, height);
     wl_surface_attach(decoration->surface, buffer, 0, 0);
+    attachShmBuffer(buffer);
 
     if (opaque)
     {
@@ -381,6 +608,7 @@ static void surfaceHandleEnter(void *data,
     window->wl.monitors[window->wl.monitorsCount++] = monitor;
 
     checkScaleChange(window);
+    _glfwInputRefreshChange(window);
 }
 
 static void surfaceHandleLeave(void *data,
@@ -402,6 +630,7 @@ static void surfaceHandleLeave(void *data,
     window->wl.monitors[--window->wl.monitorsCount] = NULL;
 
     checkScaleChange(window);
+    _glfwInputRefreshChange(window);
 }
 
 static const struct wl_surface_listener surfaceListener = {
@@ -409,6 +638,72 @@ static const struct wl_surface_listener surfaceListener = {
     surfaceHandleLeave
 };
 
+// Removes the feedback from the slots of the window
+// The presentation lock must be held when calling this
+//
+static void releasePresentationFeedback(_GLFWwindow* window,
+                                        struct wp_presentation_feedback* feedback)
+{
+    int i;
+
+    for (i = 0;  i < _GLFW_WL_PRESENTATION_FEEDBACKS;  i++)
+    {
+        if (window->wl.presentation.feedbacks[i] == feedback)
+            window->wl.presentation.feedbacks[i] = NULL;
+    }
+
+    wp_presentation_feedback_destroy(feedback);
+}
+
+static void feedbackHandleSyncOutput(void* data,
+                                     struct wp_presentation_feedback* feedback,
+                                     struct wl_output* output)
+{
+}
+
+static void feedbackHandlePresented(void* data,
+                                    struct wp_presentation_feedback* feedback,
+                                    uint32_t secondsHigh,
+                                    uint32_t secondsLow,
+                                    uint32_t nanoseconds,
+                                    uint32_t refresh,
+                                    uint32_t sequenceHigh,
+                                    uint32_t sequenceLow,
+                                    uint32_t flags)
+{
+    _GLFWwindow* window = data;
+
+    _glfwPlatformLockMutex(&_glfw.wl.presentationLock);
+
+    // Presentation times can only be compared with the timer if they are from
+    // the same clock
+    if (_glfw.wl.presentationClock == CLOCK_MONOTONIC &&
+        _glfw.timer.posix.monotonic)
+    {
+        const uint64_t seconds = ((uint64_t) secondsHigh << 32) | secondsLow;
+        window->wl.presentation.time = seconds * 1000000000 + nanoseconds;
+        window->wl.presentation.refresh = refresh;
+    }
+
+    releasePresentationFeedback(window, feedback);
+
+    _glfwPlatformUnlockMutex(&_glfw.wl.presentationLock);
+}
+
+static void feedbackHandleDiscarded(void* data,
+                                    struct wp_presentation_feedback* feedback)
+{
+    _glfwPlatformLockMutex(&_glfw.wl.presentationLock);
+    releasePresentationFeedback(data, feedback);
+    _glfwPlatformUnlockMutex(&_glfw.wl.presentationLock);
+}
+
+static const struct wp_presentation_feedback_listener feedbackListener = {
+    feedbackHandleSyncOutput,
+    feedbackHandlePresented,
+    feedbackHandleDiscarded
+};
+
 static void setIdleInhibitor(_GLFWwindow* window, GLFWbool enable)
 {
     if (enable && !window->wl.idleInhibitor && _glfw.wl.idleInhibitManager)
@@ -635,6 +930,7 @@ static GLFWbool createXdgSurface(_GLFWwindow* window)
     }
 
     wl_surface_commit(window->wl.surface);
+    _GLFW_COUNT(roundTrips);
     wl_display_roundtrip(_glfw.wl.display);
 
     return GLFW_TRUE;
@@ -651,7 +947,10 @@ static void setCursorImage(_GLFWwindow* window,
     int scale = 1;
 
     if (!wlCursor)
+    {
         buffer = cursorWayland->buffer;
+        attachShmBuffer(buffer);
+    }
     else
     {
         if (window->wl.scale > 1 && cursorWayland->cursorHiDPI)
@@ -702,16 +1001,185 @@ static void incrementCursorImage(_GLFWwindow* window)
     }
 }
 
+// Reads whatever clipboard data is available without blocking and passes on
+// the result once the source has closed its end of the pipe
+//
+static void readClipboardRequest(void)
+{
+    GLFWbool failed = GLFW_FALSE;
+
+    for (;;)
+    {
+        ssize_t count;
+
+        // Grow the buffer geometrically so large pastes stay linear
+        if (_glfw.wl.clipboardRequest.size + 4096 + 1 >
+            _glfw.wl.clipboardRequest.capacity)
+        {
+            size_t capacity = _glfw.wl.clipboardRequest.capacity * 2;
+            if (capacity < 8192)
+                capacity = 8192;
+
+            char* data = realloc(_glfw.wl.clipboardRequest.data, capacity);
+            if (!data)
+            {
+                _glfwInputError(GLFW_PLATFORM_ERROR,
+                                "Wayland: Impossible to grow clipboard string");
+                failed = GLFW_TRUE;
+                break;
+            }
+
+            _glfw.wl.clipboardRequest.data = data;
+            _glfw.wl.clipboardRequest.capacity = capacity;
+        }
+
+        count = read(_glfw.wl.clipboardRequest.fd,
+                     _glfw.wl.clipboardRequest.data +
+                     _glfw.wl.clipboardRequest.size,
+                     _glfw.wl.clipboardRequest.capacity -
+                     _glfw.wl.clipboardRequest.size - 1);
+        if (count > 0)
+        {
+            _glfw.wl.clipboardRequest.size += count;
+            continue;
+        }
+        if (count == 0)
+            break;
+        if (errno == EINTR)
+            continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return;
+
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Impossible to read from clipboard fd: %m");
+        failed = GLFW_TRUE;
+        break;
+    }
+
+    close(_glfw.wl.clipboardRequest.fd);
+    _glfw.wl.clipboardRequest.fd = -1;
+
+    char* string = _glfw.wl.clipboardRequest.data;
+    if (!failed && string)
+        string[_glfw.wl.clipboardRequest.size] = '\0';
+    else
+        failed = GLFW_TRUE;
+
+    _glfw.wl.clipboardRequest.data = NULL;
+    _glfw.wl.clipboardRequest.size = 0;
+    _glfw.wl.clipboardRequest.capacity = 0;
+
+    _glfwInputClipboardString(failed ? NULL : string);
+    free(string);
+}
+
+static void releaseClipboardSource(_GLFWclipboardSourceWayland* source)
+{
+    if (--source->references > 0)
+        return;
+
+    if (source->free)
+        source->free(source->data);
+
+    free(source->mimeType);
+    free(source);
+}
+
+// Writes as much of the clipboard data as the receiver will currently accept
+// and returns whether the write is finished, successfully or not
+//
+static GLFWbool writeClipboardData(_GLFWclipboardWriteWayland* transfer)
+{
+    const _GLFWclipboardSourceWayland* source = transfer->source;
+    GLFWbool finished = GLFW_TRUE, wasPending;
+    sigset_t sigpipe, previous, pending;
+
+    // The fd is usually a pipe, so MSG_NOSIGNAL is not available and a
+    // receiver closing its end early would raise SIGPIPE and kill the
+    // application unless the signal is blocked during the write
+    sigemptyset(&sigpipe);
+    sigaddset(&sigpipe, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &sigpipe, &previous);
+
+    sigpending(&pending);
+    wasPending = sigismember(&pending, SIGPIPE);
+
+    while (transfer->offset < source->size)
+    {
+        const ssize_t result = write(transfer->fd,
+                                     (const char*) source->data + transfer->offset,
+                                     source->size - transfer->offset);
+        if (result >= 0)
+        {
+            transfer->offset += result;
+            continue;
+        }
+
+        if (errno == EINTR)
+            continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            finished = GLFW_FALSE;
+            break;
+        }
+
+        if (errno == EPIPE)
+        {
+            // The receiver closing its end early is not our error, but the
+            // signal it raised must not be delivered once it is unblocked
+            if (!wasPending)
+            {
+                const struct timespec zero = { 0, 0 };
+                while (sigtimedwait(&sigpipe, NULL, &zero) == -1 &&
+                       errno == EINTR)
+                    ;
+            }
+        }
+        else
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Error while writing the clipboard: %m");
+        }
+
+        break;
+    }
+
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+    return finished;
+}
+
+static void finishClipboardWrite(int index)
+{
+    _GLFWclipboardWriteWayland* transfer = _glfw.wl.clipboardWrites + index;
+
+    close(transfer->fd);
+    releaseClipboardSource(transfer->source);
+
+    _glfw.wl.clipboardWriteCount--;
+    *transfer = _glfw.wl.clipboardWrites[_glfw.wl.clipboardWriteCount];
+}
+
 static void handleEvents(int timeout)
 {
     struct wl_display* display = _glfw.wl.display;
-    struct pollfd fds[] = {
-        { wl_display_get_fd(display), POLLIN },
-        { _glfw.wl.timerfd, POLLIN },
-        { _glfw.wl.cursorTimerfd, POLLIN },
-    };
+    struct pollfd fds[4 + _GLFW_CLIPBOARD_WRITE_POLL_COUNT];
+    int writeCount = _glfw.wl.clipboardWriteCount;
     ssize_t read_ret;
     uint64_t repeats, i;
+    int j;
+
+    fds[0] = (struct pollfd) { wl_display_get_fd(display), POLLIN };
+    fds[1] = (struct pollfd) { _glfw.wl.timerfd, POLLIN };
+    fds[2] = (struct pollfd) { _glfw.wl.cursorTimerfd, POLLIN };
+    fds[3] = (struct pollfd) { _glfw.wl.clipboardRequest.fd, POLLIN };
+
+    // Any writes beyond the polled ones move into the polled range as the
+    // earlier ones finish
+    if (writeCount > _GLFW_CLIPBOARD_WRITE_POLL_COUNT)
+        writeCount = _GLFW_CLIPBOARD_WRITE_POLL_COUNT;
+
+    for (j = 0;  j < writeCount;  j++)
+        fds[4 + j] = (struct pollfd) { _glfw.wl.clipboardWrites[j].fd, POLLOUT };
 
     while (wl_display_prepare_read(display) != 0)
         wl_display_dispatch_pending(display);
@@ -731,7 +1199,7 @@ static void handleEvents(int timeout)
         return;
     }
 
-    if (poll(fds, 3, timeout) > 0)
+    if (poll(fds, 4 + writeCount, timeout) > 0)
     {
         if (fds[0].revents & POLLIN)
         {
@@ -743,6 +1211,20 @@ static void handleEvents(int timeout)
             wl_display_cancel_read(display);
         }
 
+        if (fds[3].revents & (POLLIN | POLLHUP | POLLERR))
+            readClipboardRequest();
+
+        // Iterate backwards as a finished write is replaced by the last one,
+        // which may have been added while dispatching and is not yet polled
+        for (j = writeCount - 1;  j >= 0;  j--)
+        {
+            if (fds[4 + j].revents & (POLLOUT | POLLHUP | POLLERR))
+            {
+                if (writeClipboardData(_glfw.wl.clipboardWrites + j))
+                    finishClipboardWrite(j);
+            }
+        }
+
         if (fds[1].revents & POLLIN)
         {
             read_ret = read(_glfw.wl.timerfd, &repeats, sizeof(repeats));
@@ -831,6 +1313,8 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
 
 void _glfwPlatformDestroyWindow(_GLFWwindow* window)
 {
+    int i;
+
     if (window == _glfw.wl.pointerFocus)
     {
         _glfw.wl.pointerFocus = NULL;
@@ -845,6 +1329,12 @@ void _glfwPlatformDestroyWindow(_GLFWwindow* window)
     if (window->wl.idleInhibitor)
         zwp_idle_inhibitor_v1_destroy(window->wl.idleInhibitor);
 
+    for (i = 0;  i < _GLFW_WL_PRESENTATION_FEEDBACKS;  i++)
+    {
+        if (window->wl.presentation.feedbacks[i])
+            wp_presentation_feedback_destroy(window->wl.presentation.feedbacks[i]);
+    }
+
     if (window->context.destroy)
         window->context.destroy(window);
 
@@ -853,7 +1343,7 @@ void _glfwPlatformDestroyWindow(_GLFWwindow* window)
         zxdg_toplevel_decoration_v1_destroy(window->wl.xdg.decoration);
 
     if (window->wl.decorations.buffer)
-        wl_buffer_destroy(window->wl.decorations.buffer);
+        destroyShmBuffer(window->wl.decorations.buffer);
 
     if (window->wl.native)
         wl_egl_window_destroy(window->wl.native);
@@ -1157,6 +1647,61 @@ void _glfwPlatformPostEmptyEvent(void)
     wl_display_sync(_glfw.wl.display);
 }
 
+void _glfwPlatformRequestPresentTime(_GLFWwindow* window)
+{
+    if (!_glfw.wl.presentation)
+        return;
+
+    _glfwPlatformLockMutex(&_glfw.wl.presentationLock);
+
+    // The feedback applies to the next commit of the surface, which is the one
+    // made by the buffer swap
+    if (window->wl.presentation.wanted)
+    {
+        for (int i = 0;  i < _GLFW_WL_PRESENTATION_FEEDBACKS;  i++)
+        {
+            if (!window->wl.presentation.feedbacks[i])
+            {
+                struct wp_presentation_feedback* feedback =
+                    wp_presentation_feedback(_glfw.wl.presentation,
+                                             window->wl.surface);
+                wp_presentation_feedback_add_listener(feedback,
+                                                      &feedbackListener,
+                                                      window);
+                window->wl.presentation.feedbacks[i] = feedback;
+                break;
+            }
+        }
+    }
+
+    _glfwPlatformUnlockMutex(&_glfw.wl.presentationLock);
+}
+
+GLFWbool _glfwPlatformGetPresentTime(_GLFWwindow* window,
+                                     uint64_t* time, uint64_t* refresh)
+{
+    GLFWbool result = GLFW_FALSE;
+
+    if (!_glfw.wl.presentation)
+        return GLFW_FALSE;
+
+    _glfwPlatformLockMutex(&_glfw.wl.presentationLock);
+
+    // Feedback is requested from the next buffer swap on, so the first call
+    // for a window only finds estimates
+    window->wl.presentation.wanted = GLFW_TRUE;
+
+    if (window->wl.presentation.time)
+    {
+        *time = window->wl.presentation.time;
+        *refresh = window->wl.presentation.refresh;
+        result = GLFW_TRUE;
+    }
+
+    _glfwPlatformUnlockMutex(&_glfw.wl.presentationLock);
+    return result;
+}
+
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
 {
     if (xpos)
@@ -1165,6 +1710,12 @@ void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
         *ypos = window->wl.cursorPosY;
 }
 
+void _glfwPlatformSyncCursorPos(_GLFWwindow* window)
+{
+    // There is no way to query the pointer position, so the position from
+    // the last pointer event is all there is
+}
+
 static GLFWbool isPointerLocked(_GLFWwindow* window);
 
 void _glfwPlatformSetCursorPos(_GLFWwindow* window, double x, double y)
@@ -1296,7 +1847,7 @@ void _glfwPlatformDestroyCursor(_GLFWcursor* cursor)
         return;
 
     if (cursor->wl.buffer)
-        wl_buffer_destroy(cursor->wl.buffer);
+        destroyShmBuffer(cursor->wl.buffer);
 }
 
 static void relativePointerHandleRelativeMotion(void* data,
@@ -1483,25 +2034,27 @@ static void dataSourceHandleSend(void* data,
                                  const char* mimeType,
                                  int fd)
 {
-    const char* string = _glfw.wl.clipboardSendString;
-    size_t len = _glfw.wl.clipboardSendSize;
-    int ret;
+    _GLFWclipboardSourceWayland* source = _glfw.wl.clipboardSource;
+    _GLFWclipboardWriteWayland transfer;
+    _GLFWclipboardWriteWayland* writes;
 
     if (_glfw.wl.dataSource != dataSource)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
                         "Wayland: Unknown clipboard data source");
+        close(fd);
         return;
     }
 
-    if (!string)
+    if (!source)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
                         "Wayland: Copy requested from an invalid string");
+        close(fd);
         return;
     }
 
-    if (strcmp(mimeType, "text/plain;charset=utf-8") != 0)
+    if (strcmp(mimeType, source->mimeType) != 0)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
                         "Wayland: Wrong MIME type asked from clipboard");
@@ -1509,22 +2062,35 @@ static void dataSourceHandleSend(void* data,
         return;
     }
 
-    while (len > 0)
+    // A slow or stuck receiver must not be able to block the event loop
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    transfer.fd = fd;
+    transfer.offset = 0;
+    transfer.source = source;
+    source->references++;
+
+    if (writeClipboardData(&transfer))
     {
-        ret = write(fd, string, len);
-        if (ret == -1 && errno == EINTR)
-            continue;
-        if (ret == -1)
-        {
-            // TODO: also report errno maybe.
-            _glfwInputError(GLFW_PLATFORM_ERROR,
-                            "Wayland: Error while writing the clipboard");
-            close(fd);
-            return;
-        }
-        len -= ret;
+        close(fd);
+        releaseClipboardSource(source);
+        return;
+    }
+
+    writes = realloc(_glfw.wl.clipboardWrites,
+                     sizeof(_GLFWclipboardWriteWayland) *
+                     (_glfw.wl.clipboardWriteCount + 1));
+    if (!writes)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        close(fd);
+        releaseClipboardSource(source);
+        return;
     }
-    close(fd);
+
+    // The rest is written by handleEvents as the receiver drains the pipe
+    _glfw.wl.clipboardWrites = writes;
+    _glfw.wl.clipboardWrites[_glfw.wl.clipboardWriteCount++] = transfer;
 }
 
 static void dataSourceHandleCancelled(void* data,
@@ -1540,6 +2106,13 @@ static void dataSourceHandleCancelled(void* data,
     }
 
     _glfw.wl.dataSource = NULL;
+
+    // Writes already in progress keep their own reference to the data
+    if (_glfw.wl.clipboardSource)
+    {
+        releaseClipboardSource(_glfw.wl.clipboardSource);
+        _glfw.wl.clipboardSource = NULL;
+    }
 }
 
 static const struct wl_data_source_listener dataSourceListener = {
@@ -1548,46 +2121,71 @@ static const struct wl_data_source_listener dataSourceListener = {
     dataSourceHandleCancelled,
 };
 
-void _glfwPlatformSetClipboardString(const char* string)
+static void setClipboardSource(const char* mimeType,
+                               void* data, size_t size,
+                               GLFWclipboardfreefun callback)
 {
+    _GLFWclipboardSourceWayland* source;
+
     if (_glfw.wl.dataSource)
     {
         wl_data_source_destroy(_glfw.wl.dataSource);
         _glfw.wl.dataSource = NULL;
     }
 
-    if (_glfw.wl.clipboardSendString)
+    if (_glfw.wl.clipboardSource)
     {
-        free(_glfw.wl.clipboardSendString);
-        _glfw.wl.clipboardSendString = NULL;
+        releaseClipboardSource(_glfw.wl.clipboardSource);
+        _glfw.wl.clipboardSource = NULL;
     }
 
-    _glfw.wl.clipboardSendString = strdup(string);
-    if (!_glfw.wl.clipboardSendString)
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Impossible to allocate clipboard string");
-        return;
-    }
-    _glfw.wl.clipboardSendSize = strlen(string);
+    source = calloc(1, sizeof(_GLFWclipboardSourceWayland));
+    source->mimeType = _glfw_strdup(mimeType);
+    source->data = data;
+    source->size = size;
+    source->free = callback;
+    source->references = 1;
+
     _glfw.wl.dataSource =
         wl_data_device_manager_create_data_source(_glfw.wl.dataDeviceManager);
     if (!_glfw.wl.dataSource)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
                         "Wayland: Impossible to create clipboard source");
-        free(_glfw.wl.clipboardSendString);
+        releaseClipboardSource(source);
         return;
     }
+
+    _glfw.wl.clipboardSource = source;
+
     wl_data_source_add_listener(_glfw.wl.dataSource,
                                 &dataSourceListener,
                                 NULL);
-    wl_data_source_offer(_glfw.wl.dataSource, "text/plain;charset=utf-8");
+    wl_data_source_offer(_glfw.wl.dataSource, mimeType);
     wl_data_device_set_selection(_glfw.wl.dataDevice,
                                  _glfw.wl.dataSource,
                                  _glfw.wl.serial);
 }
 
+void _glfwPlatformSetClipboardString(const char* string)
+{
+    char* copy = _glfw_strdup(string);
+    if (!copy)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Impossible to allocate clipboard string");
+        return;
+    }
+
+    setClipboardSource("text/plain;charset=utf-8", copy, strlen(copy), free);
+}
+
+void _glfwPlatformSetClipboardData(const char* mime, void* data, size_t size,
+                                   GLFWclipboardfreefun callback)
+{
+    setClipboardSource(mime, data, size, callback);
+}
+
 static GLFWbool growClipboardString(void)
 {
     char* clipboard = _glfw.wl.clipboardString;
@@ -1604,11 +2202,38 @@ static GLFWbool growClipboardString(void)
     return GLFW_TRUE;
 }
 
+// Returns a copy of our own clipboard text, as reading it back through a pipe
+// would wait on writes that only this thread can make
+//
+static const char* getOwnClipboardString(void)
+{
+    const _GLFWclipboardSourceWayland* source = _glfw.wl.clipboardSource;
+
+    if (!_glfw.wl.dataSource || !source)
+        return NULL;
+    if (strcmp(source->mimeType, "text/plain;charset=utf-8") != 0)
+        return NULL;
+
+    while (source->size + 1 > _glfw.wl.clipboardSize)
+    {
+        if (!growClipboardString())
+            return NULL;
+    }
+
+    memcpy(_glfw.wl.clipboardString, source->data, source->size);
+    _glfw.wl.clipboardString[source->size] = '\0';
+    return _glfw.wl.clipboardString;
+}
+
 const char* _glfwPlatformGetClipboardString(void)
 {
     int fds[2];
     int ret;
     size_t len = 0;
+    const char* own = getOwnClipboardString();
+
+    if (own)
+        return own;
 
     if (!_glfw.wl.dataOffer)
     {
@@ -1671,6 +2296,79 @@ const char* _glfwPlatformGetClipboardString(void)
     return _glfw.wl.clipboardString;
 }
 
+void _glfwPlatformRequestClipboardString(void)
+{
+    int fds[2];
+    const char* own;
+
+    if (_glfw.wl.clipboardRequest.fd >= 0)
+        return;
+
+    own = getOwnClipboardString();
+    if (own)
+    {
+        _glfwInputClipboardString(own);
+        return;
+    }
+
+    if (!_glfw.wl.dataOffer)
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "No clipboard data has been sent yet");
+        _glfwInputClipboardString(NULL);
+        return;
+    }
+
+    if (pipe2(fds, O_CLOEXEC) < 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Impossible to create clipboard pipe fds: %m");
+        _glfwInputClipboardString(NULL);
+        return;
+    }
+
+    // Only our end is made non-blocking, the source may expect a regular pipe
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+    wl_data_offer_receive(_glfw.wl.dataOffer, "text/plain;charset=utf-8", fds[1]);
+    close(fds[1]);
+    wl_display_flush(_glfw.wl.display);
+
+    // The data is read by handleEvents as it arrives
+    _glfw.wl.clipboardRequest.fd = fds[0];
+}
+
+void _glfwTerminateShmPoolWayland(void)
+{
+    // Buffers still waiting for release were already destroyed by their owners
+    while (_glfw.wl.shmPool.buffers)
+        freeShmBuffer(_glfw.wl.shmPool.buffers);
+
+    if (_glfw.wl.shmPool.pool)
+        wl_shm_pool_destroy(_glfw.wl.shmPool.pool);
+    if (_glfw.wl.shmPool.data)
+        munmap(_glfw.wl.shmPool.data, _glfw.wl.shmPool.size);
+    if (_glfw.wl.shmPool.fd >= 0)
+        close(_glfw.wl.shmPool.fd);
+
+    free(_glfw.wl.shmPool.ranges);
+}
+
+void _glfwTerminateClipboardWayland(void)
+{
+    while (_glfw.wl.clipboardWriteCount)
+        finishClipboardWrite(_glfw.wl.clipboardWriteCount - 1);
+
+    free(_glfw.wl.clipboardWrites);
+    _glfw.wl.clipboardWrites = NULL;
+
+    if (_glfw.wl.clipboardSource)
+    {
+        releaseClipboardSource(_glfw.wl.clipboardSource);
+        _glfw.wl.clipboardSource = NULL;
+    }
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (!_glfw.vk.KHR_surface || !_glfw.vk.KHR_wayland_surface)
@@ -1680,10 +2378,12 @@ void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
     extensions[1] = "VK_KHR_wayland_surface";
 }
 
-int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
-                                                      VkPhysicalDevice device,
-                                                      uint32_t queuefamily)
+uint32_t _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
+                                                           VkPhysicalDevice device,
+                                                           uint32_t first,
+                                                           uint32_t count)
 {
+    uint32_t mask = 0;
     PFN_vkGetPhysicalDeviceWaylandPresentationSupportKHR
         vkGetPhysicalDeviceWaylandPresentationSupportKHR =
         (PFN_vkGetPhysicalDeviceWaylandPresentationSupportKHR)
@@ -1692,12 +2392,20 @@ int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
     {
         _glfwInputError(GLFW_API_UNAVAILABLE,
                         "Wayland: Vulkan instance missing VK_KHR_wayland_surface extension");
-        return VK_NULL_HANDLE;
+        return 0;
+    }
+
+    for (uint32_t i = 0;  i < count;  i++)
+    {
+        if (vkGetPhysicalDeviceWaylandPresentationSupportKHR(device,
+                                                             first + i,
+                                                             _glfw.wl.display))
+        {
+            mask |= 1u << i;
+        }
     }
 
-    return vkGetPhysicalDeviceWaylandPresentationSupportKHR(device,
-                                                            queuefamily,
-                                                            _glfw.wl.display);
+    return mask;
 }
 
 VkResult _glfwPlatformCreateWindowSurface(VkInstance instance,
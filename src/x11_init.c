@@ -241,69 +241,20 @@ static void createKeyTables(void)
         // Use XKB to determine physical key locations independently of the
         // current keyboard layout
 
-        char name[XkbKeyNameLength + 1];
+        _GLFWxkbkeys table;
         XkbDescPtr desc = XkbGetMap(_glfw.x11.display, 0, XkbUseCoreKbd);
         XkbGetNames(_glfw.x11.display, XkbKeyNamesMask, desc);
 
+        _glfwInitXkbKeys(&table);
+
         // Find the X11 key code -> GLFW key code mapping
         for (scancode = desc->min_key_code;  scancode <= desc->max_key_code;  scancode++)
         {
-            memcpy(name, desc->names->keys[scancode].name, XkbKeyNameLength);
-            name[XkbKeyNameLength] = '\0';
-
             // Map the key name to a GLFW key code. Note: We only map printable
             // keys here, and we use the US keyboard layout. The rest of the
             // keys (function keys) are mapped using traditional KeySym
             // translations.
-            if (strcmp(name, "TLDE") == 0) key = GLFW_KEY_GRAVE_ACCENT;
-            else if (strcmp(name, "AE01") == 0) key = GLFW_KEY_1;
-            else if (strcmp(name, "AE02") == 0) key = GLFW_KEY_2;
-            else if (strcmp(name, "AE03") == 0) key = GLFW_KEY_3;
-            else if (strcmp(name, "AE04") == 0) key = GLFW_KEY_4;
-            else if (strcmp(name, "AE05") == 0) key = GLFW_KEY_5;
-            else if (strcmp(name, "AE06") == 0) key = GLFW_KEY_6;
-            else if (strcmp(name, "AE07") == 0) key = GLFW_KEY_7;
-            else if (strcmp(name, "AE08") == 0) key = GLFW_KEY_8;
-            else if (strcmp(name, "AE09") == 0) key = GLFW_KEY_9;
-            else if (strcmp(name, "AE10") == 0) key = GLFW_KEY_0;
-            else if (strcmp(name, "AE11") == 0) key = GLFW_KEY_MINUS;
-            else if (strcmp(name, "AE12") == 0) key = GLFW_KEY_EQUAL;
-            else if (strcmp(name, "AD01") == 0) key = GLFW_KEY_Q;
-            else if (strcmp(name, "AD02") == 0) key = GLFW_KEY_W;
-            else if (strcmp(name, "AD03") == 0) key = GLFW_KEY_E;
-            else if (strcmp(name, "AD04") == 0) key = GLFW_KEY_R;
-            else if (strcmp(name, "AD05") == 0) key = GLFW_KEY_T;
-            else if (strcmp(name, "AD06") == 0) key = GLFW_KEY_Y;
-            else if (strcmp(name, "AD07") == 0) key = GLFW_KEY_U;
-            else if (strcmp(name, "AD08") == 0) key = GLFW_KEY_I;
-            else if (strcmp(name, "AD09") == 0) key = GLFW_KEY_O;
-            else if (strcmp(name, "AD10") == 0) key = GLFW_KEY_P;
-            else if (strcmp(name, "AD11") == 0) key = GLFW_KEY_LEFT_BRACKET;
-            else if (strcmp(name, "AD12") == 0) key = GLFW_KEY_RIGHT_BRACKET;
-            else if (strcmp(name, "AC01") == 0) key = GLFW_KEY_A;
-            else if (strcmp(name, "AC02") == 0) key = GLFW_KEY_S;
-            else if (strcmp(name, "AC03") == 0) key = GLFW_KEY_D;
-            else if (strcmp(name, "AC04") == 0) key = GLFW_KEY_F;
-            else if (strcmp(name, "AC05") == 0) key = GLFW_KEY_G;
-            else if (strcmp(name, "AC06") == 0) key = GLFW_KEY_H;
-            else if (strcmp(name, "AC07") == 0) key = GLFW_KEY_J;
-            else if (strcmp(name, "AC08") == 0) key = GLFW_KEY_K;
-            else if (strcmp(name, "AC09") == 0) key = GLFW_KEY_L;
-            else if (strcmp(name, "AC10") == 0) key = GLFW_KEY_SEMICOLON;
-            else if (strcmp(name, "AC11") == 0) key = GLFW_KEY_APOSTROPHE;
-            else if (strcmp(name, "AB01") == 0) key = GLFW_KEY_Z;
-            else if (strcmp(name, "AB02") == 0) key = GLFW_KEY_X;
-            else if (strcmp(name, "AB03") == 0) key = GLFW_KEY_C;
-            else if (strcmp(name, "AB04") == 0) key = GLFW_KEY_V;
-            else if (strcmp(name, "AB05") == 0) key = GLFW_KEY_B;
-            else if (strcmp(name, "AB06") == 0) key = GLFW_KEY_N;
-            else if (strcmp(name, "AB07") == 0) key = GLFW_KEY_M;
-            else if (strcmp(name, "AB08") == 0) key = GLFW_KEY_COMMA;
-            else if (strcmp(name, "AB09") == 0) key = GLFW_KEY_PERIOD;
-            else if (strcmp(name, "AB10") == 0) key = GLFW_KEY_SLASH;
-            else if (strcmp(name, "BKSL") == 0) key = GLFW_KEY_BACKSLASH;
-            else if (strcmp(name, "LSGT") == 0) key = GLFW_KEY_WORLD_1;
-            else key = GLFW_KEY_UNKNOWN;
+            key = _glfwGetXkbKey(&table, desc->names->keys[scancode].name);
 
             if ((scancode >= 0) && (scancode < 256))
                 _glfw.x11.keycodes[scancode] = key;
@@ -387,10 +338,8 @@ static void inputMethodInstantiateCallback(Display* display,
 //
 static Atom getSupportedAtom(Atom* supportedAtoms,
                              unsigned long atomCount,
-                             const char* atomName)
+                             Atom atom)
 {
-    const Atom atom = XInternAtom(_glfw.x11.display, atomName, False);
-
     for (unsigned int i = 0;  i < atomCount;  i++)
     {
         if (supportedAtoms[i] == atom)
@@ -402,7 +351,7 @@ static Atom getSupportedAtom(Atom* supportedAtoms,
 
 // Check whether the running window manager is EWMH-compliant
 //
-static void detectEWMH(void)
+static GLFWbool isEWMHRunning(void)
 {
     // First we read the _NET_SUPPORTING_WM_CHECK property on the root window
 
@@ -412,7 +361,7 @@ static void detectEWMH(void)
                                    XA_WINDOW,
                                    (unsigned char**) &windowFromRoot))
     {
-        return;
+        return GLFW_FALSE;
     }
 
     _glfwGrabErrorHandlerX11();
@@ -426,92 +375,182 @@ static void detectEWMH(void)
                                    XA_WINDOW,
                                    (unsigned char**) &windowFromChild))
     {
+        _glfwReleaseErrorHandlerX11();
         XFree(windowFromRoot);
-        return;
+        return GLFW_FALSE;
     }
 
     _glfwReleaseErrorHandlerX11();
 
     // If the property exists, it should contain the XID of the window
 
-    if (*windowFromRoot != *windowFromChild)
-    {
-        XFree(windowFromRoot);
-        XFree(windowFromChild);
-        return;
-    }
+    const GLFWbool running = (*windowFromRoot == *windowFromChild);
 
     XFree(windowFromRoot);
     XFree(windowFromChild);
 
-    // We are now fairly sure that an EWMH-compliant WM is currently running
-    // We can now start querying the WM about what features it supports by
-    // looking in the _NET_SUPPORTED property on the root window
-    // It should contain a list of supported EWMH protocol and state atoms
+    return running;
+}
 
+// Find which of the EWMH atoms we use are supported by the window manager
+//
+static void detectEWMH(void)
+{
     Atom* supportedAtoms = NULL;
-    const unsigned long atomCount =
-        _glfwGetWindowPropertyX11(_glfw.x11.root,
-                                  _glfw.x11.NET_SUPPORTED,
-                                  XA_ATOM,
-                                  (unsigned char**) &supportedAtoms);
+    unsigned long atomCount = 0;
+
+    // If an EWMH-compliant WM is currently running, we can query it about what
+    // features it supports by looking in the _NET_SUPPORTED property on the
+    // root window
+    // It should contain a list of supported EWMH protocol and state atoms
+    // Otherwise none of the atoms are considered supported
+
+    if (isEWMHRunning())
+    {
+        atomCount = _glfwGetWindowPropertyX11(_glfw.x11.root,
+                                              _glfw.x11.NET_SUPPORTED,
+                                              XA_ATOM,
+                                              (unsigned char**) &supportedAtoms);
+    }
 
     // See which of the atoms we support that are supported by the WM
 
     _glfw.x11.NET_WM_STATE =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_STATE");
+        getSupportedAtom(supportedAtoms, atomCount, _glfw.x11.NET_WM_STATE);
     _glfw.x11.NET_WM_STATE_ABOVE =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_STATE_ABOVE");
+        getSupportedAtom(supportedAtoms, atomCount, _glfw.x11.NET_WM_STATE_ABOVE);
     _glfw.x11.NET_WM_STATE_FULLSCREEN =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_STATE_FULLSCREEN");
+        getSupportedAtom(supportedAtoms, atomCount, _glfw.x11.NET_WM_STATE_FULLSCREEN);
     _glfw.x11.NET_WM_STATE_MAXIMIZED_VERT =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_STATE_MAXIMIZED_VERT");
+        getSupportedAtom(supportedAtoms, atomCount, _glfw.x11.NET_WM_STATE_MAXIMIZED_VERT);
     _glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_STATE_MAXIMIZED_HORZ");
+        getSupportedAtom(supportedAtoms, atomCount, _glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ);
     _glfw.x11.NET_WM_STATE_DEMANDS_ATTENTION =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_STATE_DEMANDS_ATTENTION");
+        getSupportedAtom(supportedAtoms, atomCount, _glfw.x11.NET_WM_STATE_DEMANDS_ATTENTION);
     _glfw.x11.NET_WM_FULLSCREEN_MONITORS =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_FULLSCREEN_MONITORS");
+        getSupportedAtom(supportedAtoms, atomCount, _glfw.x11.NET_WM_FULLSCREEN_MONITORS);
     _glfw.x11.NET_WM_WINDOW_TYPE =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_WINDOW_TYPE");
+        getSupportedAtom(supportedAtoms, atomCount, _glfw.x11.NET_WM_WINDOW_TYPE);
     _glfw.x11.NET_WM_WINDOW_TYPE_NORMAL =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WM_WINDOW_TYPE_NORMAL");
+        getSupportedAtom(supportedAtoms, atomCount, _glfw.x11.NET_WM_WINDOW_TYPE_NORMAL);
     _glfw.x11.NET_WORKAREA =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_WORKAREA");
+        getSupportedAtom(supportedAtoms, atomCount, _glfw.x11.NET_WORKAREA);
     _glfw.x11.NET_CURRENT_DESKTOP =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_CURRENT_DESKTOP");
+        getSupportedAtom(supportedAtoms, atomCount, _glfw.x11.NET_CURRENT_DESKTOP);
     _glfw.x11.NET_ACTIVE_WINDOW =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_ACTIVE_WINDOW");
+        getSupportedAtom(supportedAtoms, atomCount, _glfw.x11.NET_ACTIVE_WINDOW);
     _glfw.x11.NET_FRAME_EXTENTS =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_FRAME_EXTENTS");
+        getSupportedAtom(supportedAtoms, atomCount, _glfw.x11.NET_FRAME_EXTENTS);
     _glfw.x11.NET_REQUEST_FRAME_EXTENTS =
-        getSupportedAtom(supportedAtoms, atomCount, "_NET_REQUEST_FRAME_EXTENTS");
+        getSupportedAtom(supportedAtoms, atomCount, _glfw.x11.NET_REQUEST_FRAME_EXTENTS);
 
     if (supportedAtoms)
         XFree(supportedAtoms);
 }
 
+// Intern all atoms we use with a single round-trip
+//
+static void internAtoms(void)
+{
+    static const struct
+    {
+        const char* name;
+        Atom* atom;
+    } atoms[] =
+    {
+        // String format atoms
+        { "NULL", &_glfw.x11.NULL_ },
+        { "UTF8_STRING", &_glfw.x11.UTF8_STRING },
+        { "ATOM_PAIR", &_glfw.x11.ATOM_PAIR },
+
+        // Custom selection property atom
+        { "GLFW_SELECTION", &_glfw.x11.GLFW_SELECTION },
+
+        // ICCCM standard clipboard atoms
+        { "TARGETS", &_glfw.x11.TARGETS },
+        { "MULTIPLE", &_glfw.x11.MULTIPLE },
+        { "PRIMARY", &_glfw.x11.PRIMARY },
+        { "INCR", &_glfw.x11.INCR },
+        { "CLIPBOARD", &_glfw.x11.CLIPBOARD },
+
+        // Clipboard manager atoms
+        { "CLIPBOARD_MANAGER", &_glfw.x11.CLIPBOARD_MANAGER },
+        { "SAVE_TARGETS", &_glfw.x11.SAVE_TARGETS },
+
+        // Xdnd (drag and drop) atoms
+        { "XdndAware", &_glfw.x11.XdndAware },
+        { "XdndEnter", &_glfw.x11.XdndEnter },
+        { "XdndPosition", &_glfw.x11.XdndPosition },
+        { "XdndStatus", &_glfw.x11.XdndStatus },
+        { "XdndActionCopy", &_glfw.x11.XdndActionCopy },
+        { "XdndDrop", &_glfw.x11.XdndDrop },
+        { "XdndFinished", &_glfw.x11.XdndFinished },
+        { "XdndSelection", &_glfw.x11.XdndSelection },
+        { "XdndTypeList", &_glfw.x11.XdndTypeList },
+        { "text/uri-list", &_glfw.x11.text_uri_list },
+
+        // ICCCM, EWMH and Motif window property atoms
+        // These can be set safely even without WM support
+        { "WM_PROTOCOLS", &_glfw.x11.WM_PROTOCOLS },
+        { "WM_STATE", &_glfw.x11.WM_STATE },
+        { "WM_DELETE_WINDOW", &_glfw.x11.WM_DELETE_WINDOW },
+        { "_NET_SUPPORTED", &_glfw.x11.NET_SUPPORTED },
+        { "_NET_SUPPORTING_WM_CHECK", &_glfw.x11.NET_SUPPORTING_WM_CHECK },
+        { "_NET_WM_ICON", &_glfw.x11.NET_WM_ICON },
+        { "_NET_WM_PING", &_glfw.x11.NET_WM_PING },
+        { "_NET_WM_PID", &_glfw.x11.NET_WM_PID },
+        { "_NET_WM_NAME", &_glfw.x11.NET_WM_NAME },
+        { "_NET_WM_ICON_NAME", &_glfw.x11.NET_WM_ICON_NAME },
+        { "_NET_WM_BYPASS_COMPOSITOR", &_glfw.x11.NET_WM_BYPASS_COMPOSITOR },
+        { "_NET_WM_WINDOW_OPACITY", &_glfw.x11.NET_WM_WINDOW_OPACITY },
+        { "_MOTIF_WM_HINTS", &_glfw.x11.MOTIF_WM_HINTS },
+
+        // EWMH atoms that require WM support
+        // These are cleared by detectEWMH if the WM does not support them
+        { "_NET_WM_STATE", &_glfw.x11.NET_WM_STATE },
+        { "_NET_WM_STATE_ABOVE", &_glfw.x11.NET_WM_STATE_ABOVE },
+        { "_NET_WM_STATE_FULLSCREEN", &_glfw.x11.NET_WM_STATE_FULLSCREEN },
+        { "_NET_WM_STATE_MAXIMIZED_VERT", &_glfw.x11.NET_WM_STATE_MAXIMIZED_VERT },
+        { "_NET_WM_STATE_MAXIMIZED_HORZ", &_glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ },
+        { "_NET_WM_STATE_DEMANDS_ATTENTION", &_glfw.x11.NET_WM_STATE_DEMANDS_ATTENTION },
+        { "_NET_WM_FULLSCREEN_MONITORS", &_glfw.x11.NET_WM_FULLSCREEN_MONITORS },
+        { "_NET_WM_WINDOW_TYPE", &_glfw.x11.NET_WM_WINDOW_TYPE },
+        { "_NET_WM_WINDOW_TYPE_NORMAL", &_glfw.x11.NET_WM_WINDOW_TYPE_NORMAL },
+        { "_NET_WORKAREA", &_glfw.x11.NET_WORKAREA },
+        { "_NET_CURRENT_DESKTOP", &_glfw.x11.NET_CURRENT_DESKTOP },
+        { "_NET_ACTIVE_WINDOW", &_glfw.x11.NET_ACTIVE_WINDOW },
+        { "_NET_FRAME_EXTENTS", &_glfw.x11.NET_FRAME_EXTENTS },
+        { "_NET_REQUEST_FRAME_EXTENTS", &_glfw.x11.NET_REQUEST_FRAME_EXTENTS }
+    };
+
+    enum { ATOM_COUNT = sizeof(atoms) / sizeof(atoms[0]) };
+
+    char* names[ATOM_COUNT + 1];
+    Atom values[ATOM_COUNT + 1];
+    char cmName[32];
+
+    for (int i = 0;  i < ATOM_COUNT;  i++)
+        names[i] = (char*) atoms[i].name;
+
+    // The compositing manager selection name contains the screen number
+    snprintf(cmName, sizeof(cmName), "_NET_WM_CM_S%u", _glfw.x11.screen);
+    names[ATOM_COUNT] = cmName;
+
+    // Xlib sends all the requests before waiting for the first reply
+    XInternAtoms(_glfw.x11.display, names, ATOM_COUNT + 1, False, values);
+
+    for (int i = 0;  i < ATOM_COUNT;  i++)
+        *atoms[i].atom = values[i];
+
+    _glfw.x11.NET_WM_CM_Sx = values[ATOM_COUNT];
+}
+
 // Look for and initialize supported X11 extensions
 //
 static GLFWbool initExtensions(void)
 {
-    _glfw.x11.vidmode.handle = _glfw_dlopen("libXxf86vm.so.1");
-    if (_glfw.x11.vidmode.handle)
-    {
-        _glfw.x11.vidmode.QueryExtension = (PFN_XF86VidModeQueryExtension)
-            _glfw_dlsym(_glfw.x11.vidmode.handle, "XF86VidModeQueryExtension");
-        _glfw.x11.vidmode.GetGammaRamp = (PFN_XF86VidModeGetGammaRamp)
-            _glfw_dlsym(_glfw.x11.vidmode.handle, "XF86VidModeGetGammaRamp");
-        _glfw.x11.vidmode.SetGammaRamp = (PFN_XF86VidModeSetGammaRamp)
-            _glfw_dlsym(_glfw.x11.vidmode.handle, "XF86VidModeSetGammaRamp");
-        _glfw.x11.vidmode.GetGammaRampSize = (PFN_XF86VidModeGetGammaRampSize)
-            _glfw_dlsym(_glfw.x11.vidmode.handle, "XF86VidModeGetGammaRampSize");
-
-        _glfw.x11.vidmode.available =
-            XF86VidModeQueryExtension(_glfw.x11.display,
-                                      &_glfw.x11.vidmode.eventBase,
-                                      &_glfw.x11.vidmode.errorBase);
-    }
+    // NOTE: XF86VidMode is only used for gamma ramps where RandR gamma is
+    //       unavailable, so it is loaded on first use by x11_monitor.c
 
 #if defined(__CYGWIN__)
     _glfw.x11.xi.handle = _glfw_dlopen("libXi-6.so");
@@ -656,29 +695,6 @@ static GLFWbool initExtensions(void)
             _glfw_dlsym(_glfw.x11.xcursor.handle, "XcursorLibraryLoadImage");
     }
 
-#if defined(__CYGWIN__)
-    _glfw.x11.xinerama.handle = _glfw_dlopen("libXinerama-1.so");
-#else
-    _glfw.x11.xinerama.handle = _glfw_dlopen("libXinerama.so.1");
-#endif
-    if (_glfw.x11.xinerama.handle)
-    {
-        _glfw.x11.xinerama.IsActive = (PFN_XineramaIsActive)
-            _glfw_dlsym(_glfw.x11.xinerama.handle, "XineramaIsActive");
-        _glfw.x11.xinerama.QueryExtension = (PFN_XineramaQueryExtension)
-            _glfw_dlsym(_glfw.x11.xinerama.handle, "XineramaQueryExtension");
-        _glfw.x11.xinerama.QueryScreens = (PFN_XineramaQueryScreens)
-            _glfw_dlsym(_glfw.x11.xinerama.handle, "XineramaQueryScreens");
-
-        if (XineramaQueryExtension(_glfw.x11.display,
-                                   &_glfw.x11.xinerama.major,
-                                   &_glfw.x11.xinerama.minor))
-        {
-            if (XineramaIsActive(_glfw.x11.display))
-                _glfw.x11.xinerama.available = GLFW_TRUE;
-        }
-    }
-
     _glfw.x11.xkb.major = 1;
     _glfw.x11.xkb.minor = 0;
     _glfw.x11.xkb.available =
@@ -751,80 +767,41 @@ static GLFWbool initExtensions(void)
     // the keyboard mapping.
     createKeyTables();
 
-    // String format atoms
-    _glfw.x11.NULL_ = XInternAtom(_glfw.x11.display, "NULL", False);
-    _glfw.x11.UTF8_STRING = XInternAtom(_glfw.x11.display, "UTF8_STRING", False);
-    _glfw.x11.ATOM_PAIR = XInternAtom(_glfw.x11.display, "ATOM_PAIR", False);
-
-    // Custom selection property atom
-    _glfw.x11.GLFW_SELECTION =
-        XInternAtom(_glfw.x11.display, "GLFW_SELECTION", False);
-
-    // ICCCM standard clipboard atoms
-    _glfw.x11.TARGETS = XInternAtom(_glfw.x11.display, "TARGETS", False);
-    _glfw.x11.MULTIPLE = XInternAtom(_glfw.x11.display, "MULTIPLE", False);
-    _glfw.x11.PRIMARY = XInternAtom(_glfw.x11.display, "PRIMARY", False);
-    _glfw.x11.INCR = XInternAtom(_glfw.x11.display, "INCR", False);
-    _glfw.x11.CLIPBOARD = XInternAtom(_glfw.x11.display, "CLIPBOARD", False);
-
-    // Clipboard manager atoms
-    _glfw.x11.CLIPBOARD_MANAGER =
-        XInternAtom(_glfw.x11.display, "CLIPBOARD_MANAGER", False);
-    _glfw.x11.SAVE_TARGETS =
-        XInternAtom(_glfw.x11.display, "SAVE_TARGETS", False);
-
-    // Xdnd (drag and drop) atoms
-    _glfw.x11.XdndAware = XInternAtom(_glfw.x11.display, "XdndAware", False);
-    _glfw.x11.XdndEnter = XInternAtom(_glfw.x11.display, "XdndEnter", False);
-    _glfw.x11.XdndPosition = XInternAtom(_glfw.x11.display, "XdndPosition", False);
-    _glfw.x11.XdndStatus = XInternAtom(_glfw.x11.display, "XdndStatus", False);
-    _glfw.x11.XdndActionCopy = XInternAtom(_glfw.x11.display, "XdndActionCopy", False);
-    _glfw.x11.XdndDrop = XInternAtom(_glfw.x11.display, "XdndDrop", False);
-    _glfw.x11.XdndFinished = XInternAtom(_glfw.x11.display, "XdndFinished", False);
-    _glfw.x11.XdndSelection = XInternAtom(_glfw.x11.display, "XdndSelection", False);
-    _glfw.x11.XdndTypeList = XInternAtom(_glfw.x11.display, "XdndTypeList", False);
-    _glfw.x11.text_uri_list = XInternAtom(_glfw.x11.display, "text/uri-list", False);
-
-    // ICCCM, EWMH and Motif window property atoms
-    // These can be set safely even without WM support
-    // The EWMH atoms that require WM support are handled in detectEWMH
-    _glfw.x11.WM_PROTOCOLS =
-        XInternAtom(_glfw.x11.display, "WM_PROTOCOLS", False);
-    _glfw.x11.WM_STATE =
-        XInternAtom(_glfw.x11.display, "WM_STATE", False);
-    _glfw.x11.WM_DELETE_WINDOW =
-        XInternAtom(_glfw.x11.display, "WM_DELETE_WINDOW", False);
-    _glfw.x11.NET_SUPPORTED =
-        XInternAtom(_glfw.x11.display, "_NET_SUPPORTED", False);
-    _glfw.x11.NET_SUPPORTING_WM_CHECK =
-        XInternAtom(_glfw.x11.display, "_NET_SUPPORTING_WM_CHECK", False);
-    _glfw.x11.NET_WM_ICON =
-        XInternAtom(_glfw.x11.display, "_NET_WM_ICON", False);
-    _glfw.x11.NET_WM_PING =
-        XInternAtom(_glfw.x11.display, "_NET_WM_PING", False);
-    _glfw.x11.NET_WM_PID =
-        XInternAtom(_glfw.x11.display, "_NET_WM_PID", False);
-    _glfw.x11.NET_WM_NAME =
-        XInternAtom(_glfw.x11.display, "_NET_WM_NAME", False);
-    _glfw.x11.NET_WM_ICON_NAME =
-        XInternAtom(_glfw.x11.display, "_NET_WM_ICON_NAME", False);
-    _glfw.x11.NET_WM_BYPASS_COMPOSITOR =
-        XInternAtom(_glfw.x11.display, "_NET_WM_BYPASS_COMPOSITOR", False);
-    _glfw.x11.NET_WM_WINDOW_OPACITY =
-        XInternAtom(_glfw.x11.display, "_NET_WM_WINDOW_OPACITY", False);
-    _glfw.x11.MOTIF_WM_HINTS =
-        XInternAtom(_glfw.x11.display, "_MOTIF_WM_HINTS", False);
-
-    // The compositing manager selection name contains the screen number
-    {
-        char name[32];
-        snprintf(name, sizeof(name), "_NET_WM_CM_S%u", _glfw.x11.screen);
-        _glfw.x11.NET_WM_CM_Sx = XInternAtom(_glfw.x11.display, name, False);
-    }
+    internAtoms();
 
     // Detect whether an EWMH-conformant window manager is running
     detectEWMH();
 
+    // NOTE: Xinerama is only used to tell the WM which monitors a full screen
+    //       window should cover, which requires both the RandR monitor path
+    //       and WM support, so it is not even loaded otherwise
+    if (_glfw.x11.NET_WM_FULLSCREEN_MONITORS &&
+        _glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
+    {
+#if defined(__CYGWIN__)
+        _glfw.x11.xinerama.handle = _glfw_dlopen("libXinerama-1.so");
+#else
+        _glfw.x11.xinerama.handle = _glfw_dlopen("libXinerama.so.1");
+#endif
+        if (_glfw.x11.xinerama.handle)
+        {
+            _glfw.x11.xinerama.IsActive = (PFN_XineramaIsActive)
+                _glfw_dlsym(_glfw.x11.xinerama.handle, "XineramaIsActive");
+            _glfw.x11.xinerama.QueryExtension = (PFN_XineramaQueryExtension)
+                _glfw_dlsym(_glfw.x11.xinerama.handle, "XineramaQueryExtension");
+            _glfw.x11.xinerama.QueryScreens = (PFN_XineramaQueryScreens)
+                _glfw_dlsym(_glfw.x11.xinerama.handle, "XineramaQueryScreens");
+
+            if (XineramaQueryExtension(_glfw.x11.display,
+                                       &_glfw.x11.xinerama.major,
+                                       &_glfw.x11.xinerama.minor))
+            {
+                if (XineramaIsActive(_glfw.x11.display))
+                    _glfw.x11.xinerama.available = GLFW_TRUE;
+            }
+        }
+    }
+
     return GLFW_TRUE;
 }
 
@@ -897,6 +874,28 @@ static int errorHandler(Display *display, XErrorEvent* event)
     return 0;
 }
 
+#if defined(_GLFW_CALL_COUNTS)
+// Counts the Xlib calls that waited for a reply from the X server
+// This is called by Xlib after every call that sends a request on the display
+// of GLFW, including those made by the application
+//
+static int afterFunction(Display* display)
+{
+    // NOTE: During a call Xlib only reads from the connection when it waits
+    //       for a reply, so the call was a round-trip if the server is known
+    //       to have processed its last request
+    if (LastKnownRequestProcessed(display) == NextRequest(display) - 1)
+        _GLFW_COUNT(roundTrips);
+
+    // Xlib has a single after function per display, for example the one set
+    // by XSynchronize, so any previous one must still be called
+    if (_glfw.x11.afterFunction)
+        return _glfw.x11.afterFunction(display);
+
+    return 0;
+}
+#endif
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -934,7 +933,6 @@ void _glfwInputErrorX11(int error, const char* message)
 //
 Cursor _glfwCreateCursorX11(const GLFWimage* image, int xhot, int yhot)
 {
-    int i;
     Cursor cursor;
 
     if (!_glfw.x11.xcursor.handle)
@@ -947,18 +945,9 @@ Cursor _glfwCreateCursorX11(const GLFWimage* image, int xhot, int yhot)
     native->xhot = xhot;
     native->yhot = yhot;
 
-    unsigned char* source = (unsigned char*) image->pixels;
-    XcursorPixel* target = native->pixels;
-
-    for (i = 0;  i < image->width * image->height;  i++, target++, source += 4)
-    {
-        unsigned int alpha = source[3];
-
-        *target = (alpha << 24) |
-                  ((unsigned char) ((source[0] * alpha) / 255) << 16) |
-                  ((unsigned char) ((source[1] * alpha) / 255) <<  8) |
-                  ((unsigned char) ((source[2] * alpha) / 255) <<  0);
-    }
+    _glfwPremultiplyPixelsARGB((uint32_t*) native->pixels,
+                               image->pixels,
+                               (size_t) image->width * image->height);
 
     cursor = XcursorImageLoadCursor(_glfw.x11.display, native);
     XcursorImageDestroy(native);
@@ -1077,6 +1066,8 @@ int _glfwPlatformInit(void)
         _glfw_dlsym(_glfw.x11.xlib.handle, "XInitThreads");
     _glfw.x11.xlib.InternAtom = (PFN_XInternAtom)
         _glfw_dlsym(_glfw.x11.xlib.handle, "XInternAtom");
+    _glfw.x11.xlib.InternAtoms = (PFN_XInternAtoms)
+        _glfw_dlsym(_glfw.x11.xlib.handle, "XInternAtoms");
     _glfw.x11.xlib.LookupString = (PFN_XLookupString)
         _glfw_dlsym(_glfw.x11.xlib.handle, "XLookupString");
     _glfw.x11.xlib.MapRaised = (PFN_XMapRaised)
@@ -1115,6 +1106,8 @@ int _glfwPlatformInit(void)
         _glfw_dlsym(_glfw.x11.xlib.handle, "XSelectInput");
     _glfw.x11.xlib.SendEvent = (PFN_XSendEvent)
         _glfw_dlsym(_glfw.x11.xlib.handle, "XSendEvent");
+    _glfw.x11.xlib.SetAfterFunction = (PFN_XSetAfterFunction)
+        _glfw_dlsym(_glfw.x11.xlib.handle, "XSetAfterFunction");
     _glfw.x11.xlib.SetClassHint = (PFN_XSetClassHint)
         _glfw_dlsym(_glfw.x11.xlib.handle, "XSetClassHint");
     _glfw.x11.xlib.SetErrorHandler = (PFN_XSetErrorHandler)
@@ -1215,6 +1208,11 @@ int _glfwPlatformInit(void)
     _glfw.x11.root = RootWindow(_glfw.x11.display, _glfw.x11.screen);
     _glfw.x11.context = XUniqueContext();
 
+#if defined(_GLFW_CALL_COUNTS)
+    _glfw.x11.afterFunction =
+        XSetAfterFunction(_glfw.x11.display, afterFunction);
+#endif
+
     getSystemContentScale(&_glfw.x11.contentScaleX, &_glfw.x11.contentScaleY);
 
     if (!initExtensions())
@@ -1267,6 +1265,7 @@ void _glfwPlatformTerminate(void)
 
     free(_glfw.x11.primarySelectionString);
     free(_glfw.x11.clipboardString);
+    free(_glfw.x11.transfer.data);
 
     XUnregisterIMInstantiateCallback(_glfw.x11.display,
                                      NULL, NULL, NULL,
@@ -91,6 +91,7 @@ typedef int (* PFN_XGrabPointer)(Display*,Window,Bool,unsigned int,int,int,Windo
 typedef Status (* PFN_XIconifyWindow)(Display*,Window,int);
 typedef Status (* PFN_XInitThreads)(void);
 typedef Atom (* PFN_XInternAtom)(Display*,const char*,Bool);
+typedef Status (* PFN_XInternAtoms)(Display*,char**,int,Bool,Atom*);
 typedef int (* PFN_XLookupString)(XKeyEvent*,char*,int,KeySym*,XComposeStatus*);
 typedef int (* PFN_XMapRaised)(Display*,Window);
 typedef int (* PFN_XMapWindow)(Display*,Window);
@@ -110,6 +111,7 @@ typedef char* (* PFN_XResourceManagerString)(Display*);
 typedef int (* PFN_XSaveContext)(Display*,XID,XContext,const char*);
 typedef int (* PFN_XSelectInput)(Display*,Window,long);
 typedef Status (* PFN_XSendEvent)(Display*,Window,Bool,long,XEvent*);
+typedef int (* (* PFN_XSetAfterFunction)(Display*,int (*)(Display*)))(Display*);
 typedef int (* PFN_XSetClassHint)(Display*,Window,XClassHint*);
 typedef XErrorHandler (* PFN_XSetErrorHandler)(XErrorHandler);
 typedef void (* PFN_XSetICFocus)(XIC);
@@ -190,6 +192,7 @@ typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char
 #define XIconifyWindow _glfw.x11.xlib.IconifyWindow
 #define XInitThreads _glfw.x11.xlib.InitThreads
 #define XInternAtom _glfw.x11.xlib.InternAtom
+#define XInternAtoms _glfw.x11.xlib.InternAtoms
 #define XLookupString _glfw.x11.xlib.LookupString
 #define XMapRaised _glfw.x11.xlib.MapRaised
 #define XMapWindow _glfw.x11.xlib.MapWindow
@@ -209,6 +212,7 @@ typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char
 #define XSaveContext _glfw.x11.xlib.SaveContext
 #define XSelectInput _glfw.x11.xlib.SelectInput
 #define XSendEvent _glfw.x11.xlib.SendEvent
+#define XSetAfterFunction _glfw.x11.xlib.SetAfterFunction
 #define XSetClassHint _glfw.x11.xlib.SetClassHint
 #define XSetErrorHandler _glfw.x11.xlib.SetErrorHandler
 #define XSetICFocus _glfw.x11.xlib.SetICFocus
@@ -358,6 +362,8 @@ typedef VkBool32 (APIENTRY *PFN_vkGetPhysicalDeviceXcbPresentationSupportKHR)(Vk
 #include "posix_thread.h"
 #include "posix_time.h"
 #include "xkb_unicode.h"
+#include "pixels.h"
+#include "xkb_keys.h"
 #include "glx_context.h"
 #include "egl_context.h"
 #include "osmesa_context.h"
@@ -390,13 +396,18 @@ typedef struct _GLFWwindowX11
     XIC             ic;
 
     GLFWbool        overrideRedirect;
+
+    // Window state maintained from events, so queries need no round-trip
     GLFWbool        iconified;
     GLFWbool        maximized;
+    GLFWbool        visible;
+    GLFWbool        focused;
+    GLFWbool        hovered;
 
     // Whether the visual supports framebuffer transparency
     GLFWbool        transparent;
 
-    // Cached position and size used to filter out duplicate events
+    // Position and size maintained from ConfigureNotify events
     int             width, height;
     int             xpos, ypos;
 
@@ -430,10 +441,21 @@ typedef struct _GLFWlibraryX11
     XIM             im;
     // Most recent error code received by X error handler
     int             errorCode;
+    // After function that was set before the one counting round-trips
+    int             (*afterFunction)(Display*);
     // Primary selection string (while the primary selection is owned)
     char*           primarySelectionString;
     // Clipboard string (while the selection is owned)
     char*           clipboardString;
+    // Asynchronous clipboard transfer (while a request is in progress)
+    struct {
+        GLFWbool    active;
+        GLFWbool    incremental;
+        int         target;
+        char*       data;
+        size_t      size;
+        size_t      capacity;
+    } transfer;
     // Key name string
     char            keynames[GLFW_KEY_LAST + 1][5];
     // X11 keycode to GLFW key LUT
@@ -546,6 +568,7 @@ typedef struct _GLFWlibraryX11
         PFN_XIconifyWindow IconifyWindow;
         PFN_XInitThreads InitThreads;
         PFN_XInternAtom InternAtom;
+        PFN_XInternAtoms InternAtoms;
         PFN_XLookupString LookupString;
         PFN_XMapRaised MapRaised;
         PFN_XMapWindow MapWindow;
@@ -565,6 +588,7 @@ typedef struct _GLFWlibraryX11
         PFN_XSaveContext SaveContext;
         PFN_XSelectInput SelectInput;
         PFN_XSendEvent SendEvent;
+        PFN_XSetAfterFunction SetAfterFunction;
         PFN_XSetClassHint SetClassHint;
         PFN_XSetErrorHandler SetErrorHandler;
         PFN_XSetICFocus SetICFocus;
@@ -687,6 +711,8 @@ typedef struct _GLFWlibraryX11
 
     struct {
         GLFWbool    available;
+        // Whether loading has been attempted, as it is done on first use
+        GLFWbool    checked;
         void*       handle;
         int         eventBase;
         int         errorBase;
@@ -120,6 +120,9 @@ static GLFWbool waitForVisibilityNotify(_GLFWwindow* window)
             return GLFW_FALSE;
     }
 
+    // VisibilityNotify is only sent to viewable windows, so there is no need to
+    // wait for the MapNotify that preceded it
+    window->x11.visible = GLFW_TRUE;
     return GLFW_TRUE;
 }
 
@@ -147,6 +150,43 @@ static int getWindowState(_GLFWwindow* window)
     return result;
 }
 
+// Returns whether the window is maximized
+//
+static GLFWbool getWindowMaximized(_GLFWwindow* window)
+{
+    Atom* states;
+    unsigned long i;
+    GLFWbool maximized = GLFW_FALSE;
+
+    if (!_glfw.x11.NET_WM_STATE ||
+        !_glfw.x11.NET_WM_STATE_MAXIMIZED_VERT ||
+        !_glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ)
+    {
+        return maximized;
+    }
+
+    const unsigned long count =
+        _glfwGetWindowPropertyX11(window->x11.handle,
+                                  _glfw.x11.NET_WM_STATE,
+                                  XA_ATOM,
+                                  (unsigned char**) &states);
+
+    for (i = 0;  i < count;  i++)
+    {
+        if (states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_VERT ||
+            states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ)
+        {
+            maximized = GLFW_TRUE;
+            break;
+        }
+    }
+
+    if (states)
+        XFree(states);
+
+    return maximized;
+}
+
 // Returns whether the event is a selection event
 //
 static Bool isSelectionEvent(Display* display, XEvent* event, XPointer pointer)
@@ -159,6 +199,19 @@ static Bool isSelectionEvent(Display* display, XEvent* event, XPointer pointer)
            event->type == SelectionClear;
 }
 
+// Returns whether the event belongs to the asynchronous clipboard transfer
+//
+static Bool isTransferEvent(Display* display, XEvent* event, XPointer pointer)
+{
+    if (event->xany.window != _glfw.x11.helperWindowHandle)
+        return False;
+
+    return event->type == SelectionNotify ||
+           (event->type == PropertyNotify &&
+            event->xproperty.state == PropertyNewValue &&
+            event->xproperty.atom == _glfw.x11.GLFW_SELECTION);
+}
+
 // Returns whether it is a _NET_FRAME_EXTENTS event for the specified window
 //
 static Bool isFrameExtentsEvent(Display* display, XEvent* event, XPointer pointer)
@@ -780,8 +833,13 @@ static GLFWbool createNativeWindow(_GLFWwindow* window,
         _glfwCreateInputContextX11(window);
 
     _glfwPlatformSetWindowTitle(window, wndconfig->title);
-    _glfwPlatformGetWindowPos(window, &window->x11.xpos, &window->x11.ypos);
-    _glfwPlatformGetWindowSize(window, &window->x11.width, &window->x11.height);
+
+    // The window was created unmapped at the origin of the root window, so its
+    // geometry is known until the first ConfigureNotify arrives
+    window->x11.xpos = 0;
+    window->x11.ypos = 0;
+    window->x11.width = width;
+    window->x11.height = height;
 
     return GLFW_TRUE;
 }
@@ -951,6 +1009,176 @@ static void handleSelectionRequest(XEvent* event)
     XSendEvent(_glfw.x11.display, request->requestor, False, 0, &reply);
 }
 
+// Appends data to a selection transfer buffer, growing it geometrically and
+// keeping it null-terminated
+//
+static void appendSelectionData(char** buffer, size_t* size, size_t* capacity,
+                                const char* data, size_t count)
+{
+    if (*size + count + 1 > *capacity)
+    {
+        size_t required = *size + count + 1;
+        if (required < *capacity * 2)
+            required = *capacity * 2;
+        if (required < 4096)
+            required = 4096;
+
+        *buffer = realloc(*buffer, required);
+        *capacity = required;
+    }
+
+    memcpy(*buffer + *size, data, count);
+    *size += count;
+    (*buffer)[*size] = '\0';
+}
+
+// Asks the clipboard owner to convert to the current transfer target
+//
+static void requestTransferTarget(void)
+{
+    const Atom targets[] = { _glfw.x11.UTF8_STRING, XA_STRING };
+
+    XConvertSelection(_glfw.x11.display,
+                      _glfw.x11.CLIPBOARD,
+                      targets[_glfw.x11.transfer.target],
+                      _glfw.x11.GLFW_SELECTION,
+                      _glfw.x11.helperWindowHandle,
+                      CurrentTime);
+    XFlush(_glfw.x11.display);
+}
+
+// Ends the asynchronous clipboard transfer and passes on its result
+//
+static void finishTransfer(GLFWbool converted)
+{
+    char* string = NULL;
+
+    if (converted)
+    {
+        if (_glfw.x11.transfer.target == 1)
+        {
+            string = convertLatin1toUTF8(_glfw.x11.transfer.data);
+            free(_glfw.x11.transfer.data);
+        }
+        else
+            string = _glfw.x11.transfer.data;
+    }
+    else
+        free(_glfw.x11.transfer.data);
+
+    _glfw.x11.transfer.active = GLFW_FALSE;
+    _glfw.x11.transfer.incremental = GLFW_FALSE;
+    _glfw.x11.transfer.data = NULL;
+    _glfw.x11.transfer.size = 0;
+    _glfw.x11.transfer.capacity = 0;
+
+    if (!string)
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "X11: Failed to convert selection to string");
+    }
+
+    _glfwInputClipboardString(string);
+    free(string);
+}
+
+// Handles a SelectionNotify event for the asynchronous clipboard transfer
+//
+static void handleTransferNotify(const XEvent* event)
+{
+    const Atom targets[] = { _glfw.x11.UTF8_STRING, XA_STRING };
+    const int targetCount = sizeof(targets) / sizeof(targets[0]);
+    char* data = NULL;
+    Atom actualType = None;
+    int actualFormat;
+    unsigned long itemCount = 0, bytesAfter;
+
+    if (event->xselection.property != None)
+    {
+        XGetWindowProperty(_glfw.x11.display,
+                           event->xselection.requestor,
+                           event->xselection.property,
+                           0,
+                           LONG_MAX,
+                           True,
+                           AnyPropertyType,
+                           &actualType,
+                           &actualFormat,
+                           &itemCount,
+                           &bytesAfter,
+                           (unsigned char**) &data);
+    }
+
+    if (actualType == _glfw.x11.INCR)
+    {
+        // Deleting the property told the owner to start sending chunks, which
+        // will arrive as PropertyNotify events on the helper window
+        _glfw.x11.transfer.incremental = GLFW_TRUE;
+    }
+    else if (actualType == targets[_glfw.x11.transfer.target])
+    {
+        appendSelectionData(&_glfw.x11.transfer.data,
+                            &_glfw.x11.transfer.size,
+                            &_glfw.x11.transfer.capacity,
+                            data, itemCount);
+        finishTransfer(GLFW_TRUE);
+    }
+    else if (++_glfw.x11.transfer.target < targetCount)
+        requestTransferTarget();
+    else
+        finishTransfer(GLFW_FALSE);
+
+    if (data)
+        XFree(data);
+}
+
+// Handles the arrival of a chunk of an incremental clipboard transfer
+//
+static void handleTransferChunk(const XEvent* event)
+{
+    char* data = NULL;
+    Atom actualType;
+    int actualFormat;
+    unsigned long itemCount = 0, bytesAfter;
+
+    XGetWindowProperty(_glfw.x11.display,
+                       event->xproperty.window,
+                       event->xproperty.atom,
+                       0,
+                       LONG_MAX,
+                       True,
+                       AnyPropertyType,
+                       &actualType,
+                       &actualFormat,
+                       &itemCount,
+                       &bytesAfter,
+                       (unsigned char**) &data);
+
+    // A zero-length chunk marks the end of the transfer
+    if (itemCount)
+    {
+        appendSelectionData(&_glfw.x11.transfer.data,
+                            &_glfw.x11.transfer.size,
+                            &_glfw.x11.transfer.capacity,
+                            data, itemCount);
+    }
+    else
+        finishTransfer(_glfw.x11.transfer.data != NULL);
+
+    if (data)
+        XFree(data);
+}
+
+// Processes an event belonging to the asynchronous clipboard transfer
+//
+static void handleTransferEvent(const XEvent* event)
+{
+    if (event->type == SelectionNotify)
+        handleTransferNotify(event);
+    else if (_glfw.x11.transfer.incremental)
+        handleTransferChunk(event);
+}
+
 static const char* getSelectionString(Atom selection)
 {
     char** selectionString = NULL;
@@ -973,6 +1201,23 @@ static const char* getSelectionString(Atom selection)
     free(*selectionString);
     *selectionString = NULL;
 
+    // Complete any asynchronous transfer first, as it shares the notification
+    // events and the property used below
+    while (_glfw.x11.transfer.active)
+    {
+        XEvent event;
+
+        while (!XCheckIfEvent(_glfw.x11.display,
+                              &event,
+                              isTransferEvent,
+                              NULL))
+        {
+            waitForEvent(NULL);
+        }
+
+        handleTransferEvent(&event);
+    }
+
     for (size_t i = 0;  i < targetCount;  i++)
     {
         char* data;
@@ -1019,7 +1264,7 @@ static const char* getSelectionString(Atom selection)
 
         if (actualType == _glfw.x11.INCR)
         {
-            size_t size = 1;
+            size_t size = 0, capacity = 0;
             char* string = NULL;
 
             for (;;)
@@ -1048,10 +1293,8 @@ static const char* getSelectionString(Atom selection)
 
                 if (itemCount)
                 {
-                    size += itemCount;
-                    string = realloc(string, size);
-                    string[size - itemCount - 1] = '\0';
-                    strcat(string, data);
+                    appendSelectionData(&string, &size, &capacity,
+                                        data, itemCount);
                 }
 
                 if (!itemCount)
@@ -1164,7 +1407,11 @@ static void processEvent(XEvent *event)
     if (event->type == KeyPress || event->type == KeyRelease)
         keycode = event->xkey.keycode;
 
-    filtered = XFilterEvent(event, None);
+    // NOTE: Without an input method the only filter Xlib can have registered
+    //       is the one watching for an input method to start, which handles
+    //       only PropertyNotify, so motion and key events skip the filter
+    if (_glfw.x11.im || event->type == PropertyNotify)
+        filtered = XFilterEvent(event, None);
 
     if (_glfw.x11.randr.available)
     {
@@ -1172,6 +1419,7 @@ static void processEvent(XEvent *event)
         {
             XRRUpdateConfiguration(event);
             _glfwPollMonitorsX11();
+            _glfwInputRefreshChange(NULL);
             return;
         }
     }
@@ -1226,6 +1474,13 @@ static void processEvent(XEvent *event)
         return;
     }
 
+    if (_glfw.x11.transfer.active &&
+        isTransferEvent(_glfw.x11.display, event, NULL))
+    {
+        handleTransferEvent(event);
+        return;
+    }
+
     if (event->type == SelectionClear)
     {
         handleSelectionClear(event);
@@ -1255,6 +1510,18 @@ static void processEvent(XEvent *event)
             return;
         }
 
+        case MapNotify:
+        {
+            window->x11.visible = GLFW_TRUE;
+            return;
+        }
+
+        case UnmapNotify:
+        {
+            window->x11.visible = GLFW_FALSE;
+            return;
+        }
+
         case KeyPress:
         {
             const int key = translateKey(keycode);
@@ -1475,6 +1742,8 @@ static void processEvent(XEvent *event)
             if (window->cursorMode == GLFW_CURSOR_HIDDEN)
                 updateCursorImage(window);
 
+            window->x11.hovered = GLFW_TRUE;
+
             _glfwInputCursorEnter(window, GLFW_TRUE);
             _glfwInputCursorPos(window, x, y);
 
@@ -1485,7 +1754,12 @@ static void processEvent(XEvent *event)
 
         case LeaveNotify:
         {
+            window->x11.hovered = GLFW_FALSE;
             _glfwInputCursorEnter(window, GLFW_FALSE);
+
+            // XLeaveWindowEvent is XCrossingEvent
+            window->x11.lastCursorPosX = event->xcrossing.x;
+            window->x11.lastCursorPosY = event->xcrossing.y;
             return;
         }
 
@@ -1790,6 +2064,7 @@ static void processEvent(XEvent *event)
             if (window->x11.ic)
                 XSetICFocus(window->x11.ic);
 
+            window->x11.focused = GLFW_TRUE;
             _glfwInputWindowFocus(window, GLFW_TRUE);
             return;
         }
@@ -1813,6 +2088,7 @@ static void processEvent(XEvent *event)
             if (window->monitor && window->autoIconify)
                 _glfwPlatformIconifyWindow(window);
 
+            window->x11.focused = GLFW_FALSE;
             _glfwInputWindowFocus(window, GLFW_FALSE);
             return;
         }
@@ -1851,7 +2127,7 @@ static void processEvent(XEvent *event)
             }
             else if (event->xproperty.atom == _glfw.x11.NET_WM_STATE)
             {
-                const GLFWbool maximized = _glfwPlatformWindowMaximized(window);
+                const GLFWbool maximized = getWindowMaximized(window);
                 if (window->x11.maximized != maximized)
                 {
                     window->x11.maximized = maximized;
@@ -2135,28 +2411,38 @@ void _glfwPlatformSetWindowIcon(_GLFWwindow* window,
 {
     if (count)
     {
-        int i, j, longCount = 0;
+        int i, j, longCount = 0, maxPixelCount = 0;
 
         for (i = 0;  i < count;  i++)
-            longCount += 2 + images[i].width * images[i].height;
+        {
+            const int pixelCount = images[i].width * images[i].height;
+            longCount += 2 + pixelCount;
+            if (pixelCount > maxPixelCount)
+                maxPixelCount = pixelCount;
+        }
 
         long* icon = calloc(longCount, sizeof(long));
         long* target = icon;
 
+        // The property format of 32 is stored as a long per value on the client
+        // side, so the pixels are converted in bulk and then widened
+        uint32_t* pixels = calloc(maxPixelCount, sizeof(uint32_t));
+
         for (i = 0;  i < count;  i++)
         {
+            const int pixelCount = images[i].width * images[i].height;
+
             *target++ = images[i].width;
             *target++ = images[i].height;
 
-            for (j = 0;  j < images[i].width * images[i].height;  j++)
-            {
-                *target++ = (images[i].pixels[j * 4 + 0] << 16) |
-                            (images[i].pixels[j * 4 + 1] <<  8) |
-                            (images[i].pixels[j * 4 + 2] <<  0) |
-                            (images[i].pixels[j * 4 + 3] << 24);
-            }
+            _glfwConvertPixelsARGB(pixels, images[i].pixels, pixelCount);
+
+            for (j = 0;  j < pixelCount;  j++)
+                *target++ = pixels[j];
         }
 
+        free(pixels);
+
         XChangeProperty(_glfw.x11.display, window->x11.handle,
                         _glfw.x11.NET_WM_ICON,
                         XA_CARDINAL, 32,
@@ -2177,16 +2463,10 @@ void _glfwPlatformSetWindowIcon(_GLFWwindow* window,
 
 void _glfwPlatformGetWindowPos(_GLFWwindow* window, int* xpos, int* ypos)
 {
-    Window dummy;
-    int x, y;
-
-    XTranslateCoordinates(_glfw.x11.display, window->x11.handle, _glfw.x11.root,
-                          0, 0, &x, &y, &dummy);
-
     if (xpos)
-        *xpos = x;
+        *xpos = window->x11.xpos;
     if (ypos)
-        *ypos = y;
+        *ypos = window->x11.ypos;
 }
 
 void _glfwPlatformSetWindowPos(_GLFWwindow* window, int xpos, int ypos)
@@ -2215,13 +2495,10 @@ void _glfwPlatformSetWindowPos(_GLFWwindow* window, int xpos, int ypos)
 
 void _glfwPlatformGetWindowSize(_GLFWwindow* window, int* width, int* height)
 {
-    XWindowAttributes attribs;
-    XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &attribs);
-
     if (width)
-        *width = attribs.width;
+        *width = window->x11.width;
     if (height)
-        *height = attribs.height;
+        *height = window->x11.height;
 }
 
 void _glfwPlatformSetWindowSize(_GLFWwindow* window, int width, int height)
@@ -2462,6 +2739,9 @@ void _glfwPlatformHideWindow(_GLFWwindow* window)
 {
     XUnmapWindow(_glfw.x11.display, window->x11.handle);
     XFlush(_glfw.x11.display);
+
+    // Unmapping cannot be redirected by the window manager
+    window->x11.visible = GLFW_FALSE;
 }
 
 void _glfwPlatformRequestWindowAttention(_GLFWwindow* window)
@@ -2545,80 +2825,27 @@ void _glfwPlatformSetWindowMonitor(_GLFWwindow* window,
 
 int _glfwPlatformWindowFocused(_GLFWwindow* window)
 {
-    Window focused;
-    int state;
-
-    XGetInputFocus(_glfw.x11.display, &focused, &state);
-    return window->x11.handle == focused;
+    return window->x11.focused;
 }
 
 int _glfwPlatformWindowIconified(_GLFWwindow* window)
 {
-    return getWindowState(window) == IconicState;
+    return window->x11.iconified;
 }
 
 int _glfwPlatformWindowVisible(_GLFWwindow* window)
 {
-    XWindowAttributes wa;
-    XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &wa);
-    return wa.map_state == IsViewable;
+    return window->x11.visible;
 }
 
 int _glfwPlatformWindowMaximized(_GLFWwindow* window)
 {
-    Atom* states;
-    unsigned long i;
-    GLFWbool maximized = GLFW_FALSE;
-
-    if (!_glfw.x11.NET_WM_STATE ||
-        !_glfw.x11.NET_WM_STATE_MAXIMIZED_VERT ||
-        !_glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ)
-    {
-        return maximized;
-    }
-
-    const unsigned long count =
-        _glfwGetWindowPropertyX11(window->x11.handle,
-                                  _glfw.x11.NET_WM_STATE,
-                                  XA_ATOM,
-                                  (unsigned char**) &states);
-
-    for (i = 0;  i < count;  i++)
-    {
-        if (states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_VERT ||
-            states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ)
-        {
-            maximized = GLFW_TRUE;
-            break;
-        }
-    }
-
-    if (states)
-        XFree(states);
-
-    return maximized;
+    return window->x11.maximized;
 }
 
 int _glfwPlatformWindowHovered(_GLFWwindow* window)
 {
-    Window w = _glfw.x11.root;
-    while (w)
-    {
-        Window root;
-        int rootX, rootY, childX, childY;
-        unsigned int mask;
-
-        if (!XQueryPointer(_glfw.x11.display, w,
-                           &root, &w, &rootX, &rootY, &childX, &childY, &mask))
-        {
-            return GLFW_FALSE;
-        }
-
-        if (w == window->x11.handle)
-            return GLFW_TRUE;
-    }
-
-    return GLFW_FALSE;
+    return window->x11.hovered;
 }
 
 int _glfwPlatformFramebufferTransparent(_GLFWwindow* window)
@@ -2785,6 +3012,8 @@ void _glfwPlatformPollEvents(void)
 #if defined(__linux__)
     _glfwDetectJoystickConnectionLinux();
 #endif
+    // NOTE: Xlib keeps ownership of the event queue, as the input method and
+    //       the XCheckIfEvent waits in this file need Xlib event functions
     XPending(_glfw.x11.display);
 
     while (QLength(_glfw.x11.display))
@@ -2794,16 +3023,19 @@ void _glfwPlatformPollEvents(void)
         processEvent(&event);
     }
 
+    // NOTE: Raw motion is independent of the cursor position, so the cursor
+    //       only needs re-centering when deltas come from MotionNotify
     window = _glfw.x11.disabledCursorWindow;
-    if (window)
+    if (window && !window->rawMouseMotion)
     {
-        int width, height;
-        _glfwPlatformGetWindowSize(window, &width, &height);
+        const int width = window->x11.width;
+        const int height = window->x11.height;
 
-        // NOTE: Re-center the cursor only if it has moved since the last call,
-        //       to avoid breaking glfwWaitEvents with MotionNotify
-        if (window->x11.lastCursorPosX != width / 2 ||
-            window->x11.lastCursorPosY != height / 2)
+        // NOTE: Re-center the cursor only once it has strayed from the middle
+        //       of the content area, to avoid breaking glfwWaitEvents with
+        //       MotionNotify and to not send a warp after every poll
+        if (abs(window->x11.lastCursorPosX - width / 2) > width / 8 ||
+            abs(window->x11.lastCursorPosY - height / 2) > height / 8)
         {
             _glfwPlatformSetCursorPos(window, width / 2, height / 2);
         }
@@ -2842,21 +3074,44 @@ void _glfwPlatformPostEmptyEvent(void)
     XFlush(_glfw.x11.display);
 }
 
+void _glfwPlatformRequestPresentTime(_GLFWwindow* window)
+{
+}
+
+GLFWbool _glfwPlatformGetPresentTime(_GLFWwindow* window,
+                                     uint64_t* time, uint64_t* refresh)
+{
+    if (window->context.client != GLFW_NO_API &&
+        window->context.source == GLFW_NATIVE_CONTEXT_API)
+    {
+        return _glfwGetPresentTimeGLX(window, time, refresh);
+    }
+
+    return GLFW_FALSE;
+}
+
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
+{
+    if (xpos)
+        *xpos = window->x11.lastCursorPosX;
+    if (ypos)
+        *ypos = window->x11.lastCursorPosY;
+}
+
+void _glfwPlatformSyncCursorPos(_GLFWwindow* window)
 {
     Window root, child;
     int rootX, rootY, childX, childY;
     unsigned int mask;
 
-    XQueryPointer(_glfw.x11.display, window->x11.handle,
-                  &root, &child,
-                  &rootX, &rootY, &childX, &childY,
-                  &mask);
-
-    if (xpos)
-        *xpos = childX;
-    if (ypos)
-        *ypos = childY;
+    if (XQueryPointer(_glfw.x11.display, window->x11.handle,
+                      &root, &child,
+                      &rootX, &rootY, &childX, &childY,
+                      &mask))
+    {
+        window->x11.lastCursorPosX = childX;
+        window->x11.lastCursorPosY = childY;
+    }
 }
 
 void _glfwPlatformSetCursorPos(_GLFWwindow* window, double x, double y)
@@ -3047,6 +3302,30 @@ const char* _glfwPlatformGetClipboardString(void)
     return getSelectionString(_glfw.x11.CLIPBOARD);
 }
 
+void _glfwPlatformRequestClipboardString(void)
+{
+    if (_glfw.x11.transfer.active)
+        return;
+
+    if (XGetSelectionOwner(_glfw.x11.display, _glfw.x11.CLIPBOARD) ==
+        _glfw.x11.helperWindowHandle)
+    {
+        // We own the clipboard, so there is nothing to transfer
+        _glfwInputClipboardString(_glfw.x11.clipboardString);
+        return;
+    }
+
+    _glfw.x11.transfer.active = GLFW_TRUE;
+    _glfw.x11.transfer.target = 0;
+    requestTransferTarget();
+}
+
+void _glfwPlatformSetClipboardData(const char* mime, void* data, size_t size,
+                                   GLFWclipboardfreefun callback)
+{
+    _glfwSetClipboardDataAsString(mime, data, size, callback);
+}
+
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
     if (!_glfw.vk.KHR_surface)
@@ -3068,10 +3347,12 @@ void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
         extensions[1] = "VK_KHR_xlib_surface";
 }
 
-int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
-                                                      VkPhysicalDevice device,
-                                                      uint32_t queuefamily)
+uint32_t _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
+                                                           VkPhysicalDevice device,
+                                                           uint32_t first,
+                                                           uint32_t count)
 {
+    uint32_t mask = 0;
     VisualID visualID = XVisualIDFromVisual(DefaultVisual(_glfw.x11.display,
                                                           _glfw.x11.screen));
 
@@ -3085,7 +3366,7 @@ int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
         {
             _glfwInputError(GLFW_API_UNAVAILABLE,
                             "X11: Vulkan instance missing VK_KHR_xcb_surface extension");
-            return GLFW_FALSE;
+            return 0;
         }
 
         xcb_connection_t* connection = XGetXCBConnection(_glfw.x11.display);
@@ -3093,13 +3374,19 @@ int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
         {
             _glfwInputError(GLFW_PLATFORM_ERROR,
                             "X11: Failed to retrieve XCB connection");
-            return GLFW_FALSE;
+            return 0;
         }
 
-        return vkGetPhysicalDeviceXcbPresentationSupportKHR(device,
-                                                            queuefamily,
-                                                            connection,
-                                                            visualID);
+        for (uint32_t i = 0;  i < count;  i++)
+        {
+            if (vkGetPhysicalDeviceXcbPresentationSupportKHR(device,
+                                                             first + i,
+                                                             connection,
+                                                             visualID))
+            {
+                mask |= 1u << i;
+            }
+        }
     }
     else
     {
@@ -3111,14 +3398,22 @@ int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
         {
             _glfwInputError(GLFW_API_UNAVAILABLE,
                             "X11: Vulkan instance missing VK_KHR_xlib_surface extension");
-            return GLFW_FALSE;
+            return 0;
         }
 
-        return vkGetPhysicalDeviceXlibPresentationSupportKHR(device,
-                                                             queuefamily,
-                                                             _glfw.x11.display,
-                                                             visualID);
+        for (uint32_t i = 0;  i < count;  i++)
+        {
+            if (vkGetPhysicalDeviceXlibPresentationSupportKHR(device,
+                                                              first + i,
+                                                              _glfw.x11.display,
+                                                              visualID))
+            {
+                mask |= 1u << i;
+            }
+        }
     }
+
+    return mask;
 }
 
 VkResult _glfwPlatformCreateWindowSurface(VkInstance instance,
@@ -0,0 +1,165 @@
+//========================================================================
+// GLFW 3.4 - www.glfw.org
+//------------------------------------------------------------------------
+// Copyright (c) 2006-2019 Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+#include "xkb_keys.h"
+
+#define GLFW_INCLUDE_NONE
+#include "../include/GLFW/glfw3.h"
+
+#include <string.h>
+
+// XKB key names are four bytes, padded with zeroes when shorter
+//
+#define _GLFW_XKB_KEY_NAME_LENGTH 4
+
+// The physical keys mapped by name, using the US keyboard layout
+//
+// Only printable keys are mapped by name, the rest (function keys) are mapped
+// using traditional KeySym translations
+//
+static const struct
+{
+    char name[_GLFW_XKB_KEY_NAME_LENGTH + 1];
+    short key;
+} keyNames[] =
+{
+    { "TLDE", GLFW_KEY_GRAVE_ACCENT },
+    { "AE01", GLFW_KEY_1 },
+    { "AE02", GLFW_KEY_2 },
+    { "AE03", GLFW_KEY_3 },
+    { "AE04", GLFW_KEY_4 },
+    { "AE05", GLFW_KEY_5 },
+    { "AE06", GLFW_KEY_6 },
+    { "AE07", GLFW_KEY_7 },
+    { "AE08", GLFW_KEY_8 },
+    { "AE09", GLFW_KEY_9 },
+    { "AE10", GLFW_KEY_0 },
+    { "AE11", GLFW_KEY_MINUS },
+    { "AE12", GLFW_KEY_EQUAL },
+    { "AD01", GLFW_KEY_Q },
+    { "AD02", GLFW_KEY_W },
+    { "AD03", GLFW_KEY_E },
+    { "AD04", GLFW_KEY_R },
+    { "AD05", GLFW_KEY_T },
+    { "AD06", GLFW_KEY_Y },
+    { "AD07", GLFW_KEY_U },
+    { "AD08", GLFW_KEY_I },
+    { "AD09", GLFW_KEY_O },
+    { "AD10", GLFW_KEY_P },
+    { "AD11", GLFW_KEY_LEFT_BRACKET },
+    { "AD12", GLFW_KEY_RIGHT_BRACKET },
+    { "AC01", GLFW_KEY_A },
+    { "AC02", GLFW_KEY_S },
+    { "AC03", GLFW_KEY_D },
+    { "AC04", GLFW_KEY_F },
+    { "AC05", GLFW_KEY_G },
+    { "AC06", GLFW_KEY_H },
+    { "AC07", GLFW_KEY_J },
+    { "AC08", GLFW_KEY_K },
+    { "AC09", GLFW_KEY_L },
+    { "AC10", GLFW_KEY_SEMICOLON },
+    { "AC11", GLFW_KEY_APOSTROPHE },
+    { "AB01", GLFW_KEY_Z },
+    { "AB02", GLFW_KEY_X },
+    { "AB03", GLFW_KEY_C },
+    { "AB04", GLFW_KEY_V },
+    { "AB05", GLFW_KEY_B },
+    { "AB06", GLFW_KEY_N },
+    { "AB07", GLFW_KEY_M },
+    { "AB08", GLFW_KEY_COMMA },
+    { "AB09", GLFW_KEY_PERIOD },
+    { "AB10", GLFW_KEY_SLASH },
+    { "BKSL", GLFW_KEY_BACKSLASH },
+    { "LSGT", GLFW_KEY_WORLD_1 }
+};
+
+// Packs a key name into an integer so it can be compared in one operation
+//
+static uint32_t packKeyName(const char* name)
+{
+    uint32_t value;
+    memcpy(&value, name, sizeof(value));
+    return value;
+}
+
+// Returns the first slot to probe for the specified packed key name
+//
+static unsigned int hashKeyName(uint32_t value)
+{
+    // Fibonacci hashing, keeping the top bits of the product
+    return (unsigned int) ((value * 2654435761u) >> 25) &
+           (_GLFW_XKB_KEY_SLOTS - 1);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Fills the key name hash table
+//
+void _glfwInitXkbKeys(_GLFWxkbkeys* table)
+{
+    size_t i;
+
+    memset(table, 0, sizeof(_GLFWxkbkeys));
+
+    for (i = 0;  i < sizeof(keyNames) / sizeof(keyNames[0]);  i++)
+    {
+        const uint32_t value = packKeyName(keyNames[i].name);
+        unsigned int slot = hashKeyName(value);
+
+        while (table->names[slot])
+            slot = (slot + 1) & (_GLFW_XKB_KEY_SLOTS - 1);
+
+        table->names[slot] = value;
+        table->keys[slot] = keyNames[i].key;
+    }
+}
+
+// Returns the GLFW key for the specified four byte XKB key name, which need
+// not be null-terminated, or GLFW_KEY_UNKNOWN if it is not mapped by name
+//
+int _glfwGetXkbKey(const _GLFWxkbkeys* table, const char* name)
+{
+    const uint32_t value = packKeyName(name);
+    unsigned int slot = hashKeyName(value);
+
+    // An all-zero name is unset and would match an empty slot
+    if (!value)
+        return GLFW_KEY_UNKNOWN;
+
+    while (table->names[slot])
+    {
+        if (table->names[slot] == value)
+            return table->keys[slot];
+
+        slot = (slot + 1) & (_GLFW_XKB_KEY_SLOTS - 1);
+    }
+
+    return GLFW_KEY_UNKNOWN;
+}
+
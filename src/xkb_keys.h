@@ -0,0 +1,43 @@
+//========================================================================
+// GLFW 3.4 - www.glfw.org
+//------------------------------------------------------------------------
+// Copyright (c) 2006-2019 Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+#include <stdint.h>
+
+// The number of slots in the XKB key name hash table, a power of two at least
+// twice the number of mapped key names
+//
+#define _GLFW_XKB_KEY_SLOTS 128
+
+// Hash table mapping XKB key names, packed into 32-bit integers, to GLFW keys
+//
+typedef struct _GLFWxkbkeys
+{
+    uint32_t        names[_GLFW_XKB_KEY_SLOTS];
+    short           keys[_GLFW_XKB_KEY_SLOTS];
+} _GLFWxkbkeys;
+
+void _glfwInitXkbKeys(_GLFWxkbkeys* table);
+int _glfwGetXkbKey(const _GLFWxkbkeys* table, const char* name);
@@ -0,0 +1,298 @@
+//========================================================================
+// Frame capture throughput test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test renders the triangle of the offscreen example into a hidden
+// window and captures every frame, first with a synchronous glReadPixels and
+// then with glfwMapFramebuffer, and reports the throughput of each
+//
+// On the null platform, -e selects a headless EGL context
+//
+//========================================================================
+
+#include <glad/gl.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include "linmath.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "getopt.h"
+
+static const struct
+{
+    float x, y;
+    float r, g, b;
+} vertices[3] =
+{
+    { -0.6f, -0.4f, 1.f, 0.f, 0.f },
+    {  0.6f, -0.4f, 0.f, 1.f, 0.f },
+    {   0.f,  0.6f, 0.f, 0.f, 1.f }
+};
+
+static const char* vertex_shader_text =
+"#version 110\n"
+"uniform mat4 MVP;\n"
+"attribute vec3 vCol;\n"
+"attribute vec2 vPos;\n"
+"varying vec3 color;\n"
+"void main()\n"
+"{\n"
+"    gl_Position = MVP * vec4(vPos, 0.0, 1.0);\n"
+"    color = vCol;\n"
+"}\n";
+
+static const char* fragment_shader_text =
+"#version 110\n"
+"varying vec3 color;\n"
+"void main()\n"
+"{\n"
+"    gl_FragColor = vec4(color, 1.0);\n"
+"}\n";
+
+static GLint mvp_location;
+
+static void usage(void)
+{
+    printf("Usage: capture [-e] [-n FRAMES] [-s WIDTHxHEIGHT] [-b BUFFERS]\n");
+    printf("       capture -h\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static GLFWwindow* create_window(int width, int height, int buffers)
+{
+    GLFWwindow* window;
+    GLuint vertex_buffer, vertex_shader, fragment_shader, program;
+    GLint vpos_location, vcol_location;
+
+    glfwWindowHint(GLFW_READBACK_BUFFERS, buffers);
+
+    window = glfwCreateWindow(width, height, "Capture", NULL, NULL);
+    if (!window)
+        return NULL;
+
+    glfwMakeContextCurrent(window);
+    gladLoadGL(glfwGetProcAddress);
+
+    glGenBuffers(1, &vertex_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+    vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertex_shader, 1, &vertex_shader_text, NULL);
+    glCompileShader(vertex_shader);
+
+    fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragment_shader, 1, &fragment_shader_text, NULL);
+    glCompileShader(fragment_shader);
+
+    program = glCreateProgram();
+    glAttachShader(program, vertex_shader);
+    glAttachShader(program, fragment_shader);
+    glLinkProgram(program);
+
+    mvp_location = glGetUniformLocation(program, "MVP");
+    vpos_location = glGetAttribLocation(program, "vPos");
+    vcol_location = glGetAttribLocation(program, "vCol");
+
+    glEnableVertexAttribArray(vpos_location);
+    glVertexAttribPointer(vpos_location, 2, GL_FLOAT, GL_FALSE,
+                          sizeof(vertices[0]), (void*) 0);
+    glEnableVertexAttribArray(vcol_location);
+    glVertexAttribPointer(vcol_location, 3, GL_FLOAT, GL_FALSE,
+                          sizeof(vertices[0]), (void*) (sizeof(float) * 2));
+
+    glUseProgram(program);
+
+    return window;
+}
+
+static void draw_frame(GLFWwindow* window, int frame)
+{
+    int width, height;
+    float ratio;
+    mat4x4 m, p, mvp;
+
+    glfwGetFramebufferSize(window, &width, &height);
+    ratio = width / (float) height;
+
+    glViewport(0, 0, width, height);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    mat4x4_identity(m);
+    mat4x4_rotate_Z(m, m, frame * 0.01f);
+    mat4x4_ortho(p, -ratio, ratio, -1.f, 1.f, 1.f, -1.f);
+    mat4x4_mul(mvp, p, m);
+
+    glUniformMatrix4fv(mvp_location, 1, GL_FALSE, (const GLfloat*) mvp);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+}
+
+static void report(const char* name, int frames, int width, int height,
+                   double elapsed)
+{
+    const double megabytes = (double) width * height * 4 * frames / 1e6;
+
+    printf("%s: %i frames in %0.3f s (%0.1f frames/s, %0.1f MB/s)\n",
+           name, frames, elapsed, frames / elapsed, megabytes / elapsed);
+}
+
+static void benchmark_read_pixels(int frames, int width, int height,
+                                  unsigned char* copy)
+{
+    int i;
+    double start;
+    GLFWwindow* window = create_window(width, height, 0);
+    if (!window)
+        return;
+
+    start = glfwGetTime();
+
+    for (i = 0;  i < frames;  i++)
+    {
+        draw_frame(window, i);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, copy);
+        glfwSwapBuffers(window);
+    }
+
+    report("glReadPixels", frames, width, height, glfwGetTime() - start);
+
+    glfwDestroyWindow(window);
+}
+
+static void benchmark_map_framebuffer(int frames, int width, int height,
+                                      int buffers, unsigned char* copy)
+{
+    int i, captured = 0;
+    uint64_t last = 0;
+    double start;
+    GLFWframebufferdesc desc;
+    GLFWwindow* window = create_window(width, height, buffers);
+    if (!window)
+        return;
+
+    start = glfwGetTime();
+
+    for (i = 0;  i < frames;  i++)
+    {
+        draw_frame(window, i);
+        glfwSwapBuffers(window);
+
+        if (glfwMapFramebuffer(window, &desc) && desc.frame != last)
+        {
+            memcpy(copy, desc.pixels, (size_t) desc.stride * desc.height);
+            last = desc.frame;
+            captured++;
+        }
+    }
+
+    // Collect the frames still in flight
+    glFinish();
+
+    while (glfwMapFramebuffer(window, &desc) && desc.frame != last)
+    {
+        memcpy(copy, desc.pixels, (size_t) desc.stride * desc.height);
+        last = desc.frame;
+        captured++;
+    }
+
+    glfwUnmapFramebuffer(window);
+
+    report("glfwMapFramebuffer", captured, width, height, glfwGetTime() - start);
+    if (captured < frames)
+        printf("  %i frames were overwritten before they completed\n",
+               frames - captured);
+
+    glfwDestroyWindow(window);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, frames = 300, width = 1920, height = 1080, buffers = 3;
+    int api = GLFW_NATIVE_CONTEXT_API;
+    unsigned char* copy;
+
+    while ((ch = getopt(argc, argv, "b:ehn:s:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'b':
+                buffers = atoi(optarg);
+                break;
+            case 'e':
+                api = GLFW_EGL_CONTEXT_API;
+                break;
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+            case 'n':
+                frames = atoi(optarg);
+                break;
+            case 's':
+                if (sscanf(optarg, "%ix%i", &width, &height) != 2)
+                {
+                    usage();
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (frames < 1 || width < 1 || height < 1 || buffers < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, api);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    printf("Capturing %i frames at %ix%i with %i readback buffers\n",
+           frames, width, height, buffers);
+
+    copy = malloc((size_t) width * height * 4);
+
+    benchmark_read_pixels(frames, width, height, copy);
+    benchmark_map_framebuffer(frames, width, height, buffers, copy);
+
+    free(copy);
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
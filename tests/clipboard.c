@@ -33,6 +33,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "getopt.h"
 
@@ -42,9 +43,28 @@
  #define MODIFIER GLFW_MOD_CONTROL
 #endif
 
+static char* large_string = NULL;
+static double request_time;
+
 static void usage(void)
 {
-    printf("Usage: clipboard [-h]\n");
+    printf("Usage: clipboard [-h] [-s MIB]\n");
+    printf("Options:\n");
+    printf("  -s MIB  copy a generated string of MIB mebibytes instead\n");
+}
+
+static char* generate_string(long mebibytes)
+{
+    const char pattern[] = "The quick brown fox jumps over the lazy dog\n";
+    const size_t size = (size_t) mebibytes * 1024 * 1024;
+    char* string = malloc(size + 1);
+    size_t i;
+
+    for (i = 0;  i < size;  i++)
+        string[i] = pattern[i % (sizeof(pattern) - 1)];
+
+    string[size] = '\0';
+    return string;
 }
 
 static void error_callback(int error, const char* description)
@@ -52,6 +72,24 @@ static void error_callback(int error, const char* description)
     fprintf(stderr, "Error: %s\n", description);
 }
 
+static void clipboard_callback(GLFWwindow* window, const char* string)
+{
+    const double elapsed = glfwGetTime() - request_time;
+
+    if (string)
+    {
+        printf("Clipboard request completed after %0.3f ms with %lu bytes\n",
+               elapsed * 1000.0, (unsigned long) strlen(string));
+    }
+    else
+        printf("Clipboard request completed without a string\n");
+}
+
+static void clipboard_free_callback(void* data)
+{
+    printf("Clipboard data released\n");
+}
+
 static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
     if (action != GLFW_PRESS)
@@ -74,14 +112,37 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
                 else
                     printf("Clipboard does not contain a string\n");
             }
+            else if (mods == (MODIFIER | GLFW_MOD_SHIFT))
+            {
+                printf("Requesting clipboard contents\n");
+                request_time = glfwGetTime();
+                glfwRequestClipboardString(window, clipboard_callback);
+            }
             break;
 
         case GLFW_KEY_C:
             if (mods == MODIFIER)
             {
-                const char* string = "Hello GLFW World!";
-                glfwSetClipboardString(NULL, string);
-                printf("Setting clipboard to \"%s\"\n", string);
+                if (large_string)
+                {
+                    glfwSetClipboardString(NULL, large_string);
+                    printf("Setting clipboard to %lu bytes\n",
+                           (unsigned long) strlen(large_string));
+                }
+                else
+                {
+                    const char* string = "Hello GLFW World!";
+                    glfwSetClipboardString(NULL, string);
+                    printf("Setting clipboard to \"%s\"\n", string);
+                }
+            }
+            else if (mods == (MODIFIER | GLFW_MOD_SHIFT) && large_string)
+            {
+                glfwSetClipboardData("text/plain;charset=utf-8",
+                                     large_string, strlen(large_string),
+                                     clipboard_free_callback);
+                printf("Setting clipboard to %lu bytes without copying\n",
+                       (unsigned long) strlen(large_string));
             }
             break;
     }
@@ -92,7 +153,7 @@ int main(int argc, char** argv)
     int ch;
     GLFWwindow* window;
 
-    while ((ch = getopt(argc, argv, "h")) != -1)
+    while ((ch = getopt(argc, argv, "hs:")) != -1)
     {
         switch (ch)
         {
@@ -100,6 +161,10 @@ int main(int argc, char** argv)
                 usage();
                 exit(EXIT_SUCCESS);
 
+            case 's':
+                large_string = generate_string(strtol(optarg, NULL, 10));
+                break;
+
             default:
                 usage();
                 exit(EXIT_FAILURE);
@@ -140,6 +205,7 @@ int main(int argc, char** argv)
     }
 
     glfwTerminate();
+    free(large_string);
     exit(EXIT_SUCCESS);
 }
 
@@ -28,6 +28,11 @@
 //
 // Custom cursor image generation by urraka.
 //
+// Pressing B creates, sets and destroys a thousand identical and then
+// a thousand distinct custom cursors.  If GLFW was built with call counting,
+// it also reports how many shared memory mappings that needed and warns if
+// each cursor needed its own.
+//
 //========================================================================
 
 #include <glad/gl.h>
@@ -46,6 +51,7 @@
 #include "linmath.h"
 
 #define CURSOR_FRAME_COUNT 60
+#define BENCHMARK_CURSOR_COUNT 1000
 
 static const char* vertex_shader_text =
 "#version 110\n"
@@ -93,15 +99,13 @@ static float star(int x, int y, float t)
     return (float) fmax(0.f, fmin(1.f, i * salpha * 0.2f + salpha * xalpha * yalpha));
 }
 
-static GLFWcursor* create_cursor_frame(float t)
+static void generate_star_image(unsigned char* buffer, float t)
 {
     int i = 0, x, y;
-    unsigned char buffer[64 * 64 * 4];
-    const GLFWimage image = { 64, 64, buffer };
 
-    for (y = 0;  y < image.width;  y++)
+    for (y = 0;  y < 64;  y++)
     {
-        for (x = 0;  x < image.height;  x++)
+        for (x = 0;  x < 64;  x++)
         {
             buffer[i++] = 255;
             buffer[i++] = 255;
@@ -109,10 +113,65 @@ static GLFWcursor* create_cursor_frame(float t)
             buffer[i++] = (unsigned char) (255 * star(x, y, t));
         }
     }
+}
+
+static GLFWcursor* create_cursor_frame(float t)
+{
+    unsigned char buffer[64 * 64 * 4];
+    const GLFWimage image = { 64, 64, buffer };
 
+    generate_star_image(buffer, t);
     return glfwCreateCursor(&image, image.width / 2, image.height / 2);
 }
 
+static void benchmark_cursors(GLFWwindow* window, int distinct)
+{
+    int i;
+    double elapsed;
+    unsigned char buffer[64 * 64 * 4];
+    const GLFWimage image = { 64, 64, buffer };
+    GLFWcursor* cursors[BENCHMARK_CURSOR_COUNT];
+    GLFWcallcounts counts;
+
+    generate_star_image(buffer, 0.f);
+
+    glfwResetCallCounts();
+    elapsed = glfwGetTime();
+
+    for (i = 0;  i < BENCHMARK_CURSOR_COUNT;  i++)
+    {
+        if (distinct)
+        {
+            // Make the image unique without changing how it looks
+            buffer[0] = (unsigned char) (i & 255);
+            buffer[4] = (unsigned char) (i >> 8);
+        }
+
+        cursors[i] = glfwCreateCursor(&image, 32, 32);
+        glfwSetCursor(window, cursors[i]);
+    }
+
+    glfwSetCursor(window, NULL);
+
+    for (i = 0;  i < BENCHMARK_CURSOR_COUNT;  i++)
+        glfwDestroyCursor(cursors[i]);
+
+    elapsed = glfwGetTime() - elapsed;
+
+    printf("Created, set and destroyed %i %s cursors in %0.3f ms (%0.3f ms each)\n",
+           BENCHMARK_CURSOR_COUNT, distinct ? "distinct" : "identical",
+           elapsed * 1000.0, elapsed * 1000.0 / BENCHMARK_CURSOR_COUNT);
+
+    if (glfwGetCallCounts(&counts))
+    {
+        printf("  %i shared memory mappings were created\n",
+               (int) counts.shmMappings);
+
+        if (counts.shmMappings >= BENCHMARK_CURSOR_COUNT)
+            printf("  Each cursor needed a mapping of its own\n");
+    }
+}
+
 static GLFWcursor* create_tracking_cursor(void)
 {
     int i = 0, x, y;
@@ -169,6 +228,11 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
             break;
         }
 
+        case GLFW_KEY_B:
+            benchmark_cursors(window, GLFW_FALSE);
+            benchmark_cursors(window, GLFW_TRUE);
+            break;
+
         case GLFW_KEY_ESCAPE:
         {
             if (glfwGetInputMode(window, GLFW_CURSOR) != GLFW_CURSOR_DISABLED)
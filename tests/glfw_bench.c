@@ -0,0 +1,441 @@
+//========================================================================
+// Headless benchmark suite
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+//
+// This program times the common paths of GLFW that do not need a user, from
+// initialization and window and context creation to event dispatch and the
+// timer, and writes the results to stdout as JSON so that they can be
+// compared between builds and releases
+//
+// It is intended for the null platform, where -e selects a headless EGL
+// context instead of OSMesa, for example with a software renderer:
+//
+//   EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 ./glfw_bench -e
+//
+// It also runs on a desktop platform, for example X11 under Xvfb
+//
+// If GLFW was built with call counting, the calls counted by GLFW during each
+// benchmark are included as well
+//
+//========================================================================
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "getopt.h"
+
+// The library has its own copy of the default mappings
+#define _glfwDefaultMappings default_mappings
+#include "mappings.h"
+#undef _glfwDefaultMappings
+
+typedef struct
+{
+    const char* name;
+    int iterations;
+    // Returns the number of timer ticks taken, or zero on failure
+    uint64_t (*run)(int iterations);
+} Benchmark;
+
+static int api = GLFW_NATIVE_CONTEXT_API;
+static char* mappings;
+
+static void usage(void)
+{
+    printf("Usage: glfw_bench [-e|-o] [-n SCALE] [-b BENCHMARK]\n");
+    printf("  -e use EGL\n");
+    printf("  -o use OSMesa\n");
+    printf("  -n multiply the iterations of each benchmark by SCALE\n");
+    printf("  -b run only the named benchmark\n");
+    printf("  -h show this help\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static GLFWwindow* create_window(int client)
+{
+    glfwDefaultWindowHints();
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CLIENT_API, client);
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, api);
+
+    return glfwCreateWindow(64, 64, "Benchmark", NULL, NULL);
+}
+
+static uint64_t run_init_terminate(int iterations)
+{
+    int i;
+    uint64_t elapsed = 0;
+
+    // The timer is only available while GLFW is initialized, but the raw timer
+    // value is not affected by the offset that glfwInit resets
+    for (i = 0;  i < iterations;  i++)
+    {
+        const uint64_t start = glfwGetTimerValue();
+
+        glfwTerminate();
+        if (!glfwInit())
+            exit(EXIT_FAILURE);
+
+        elapsed += glfwGetTimerValue() - start;
+    }
+
+    return elapsed;
+}
+
+static uint64_t run_window_create_destroy(int iterations)
+{
+    int i;
+    const uint64_t start = glfwGetTimerValue();
+
+    for (i = 0;  i < iterations;  i++)
+    {
+        GLFWwindow* window = create_window(GLFW_NO_API);
+        if (!window)
+            return 0;
+
+        glfwDestroyWindow(window);
+    }
+
+    return glfwGetTimerValue() - start;
+}
+
+static uint64_t run_context_create_destroy(int iterations)
+{
+    int i;
+    const uint64_t start = glfwGetTimerValue();
+
+    for (i = 0;  i < iterations;  i++)
+    {
+        GLFWwindow* window = create_window(GLFW_OPENGL_API);
+        if (!window)
+            return 0;
+
+        glfwMakeContextCurrent(window);
+        glfwDestroyWindow(window);
+    }
+
+    return glfwGetTimerValue() - start;
+}
+
+static uint64_t run_make_context_current(int iterations)
+{
+    int i;
+    uint64_t start, elapsed;
+    GLFWwindow* windows[2];
+
+    windows[0] = create_window(GLFW_OPENGL_API);
+    if (!windows[0])
+        return 0;
+
+    windows[1] = create_window(GLFW_OPENGL_API);
+    if (!windows[1])
+    {
+        glfwDestroyWindow(windows[0]);
+        return 0;
+    }
+
+    // Alternate between the contexts so that every call switches
+    start = glfwGetTimerValue();
+
+    for (i = 0;  i < iterations;  i++)
+        glfwMakeContextCurrent(windows[i & 1]);
+
+    elapsed = glfwGetTimerValue() - start;
+
+    glfwMakeContextCurrent(NULL);
+    glfwDestroyWindow(windows[0]);
+    glfwDestroyWindow(windows[1]);
+    return elapsed;
+}
+
+static uint64_t run_update_gamepad_mappings(int iterations)
+{
+    int i;
+    const uint64_t start = glfwGetTimerValue();
+
+    // This is the same work as loading all of SDL_GameControllerDB at startup
+    for (i = 0;  i < iterations;  i++)
+    {
+        if (!glfwUpdateGamepadMappings(mappings))
+            return 0;
+    }
+
+    return glfwGetTimerValue() - start;
+}
+
+static uint64_t run_poll_events(int iterations)
+{
+    int i;
+    uint64_t start, elapsed;
+    GLFWwindow* window = create_window(GLFW_NO_API);
+    if (!window)
+        return 0;
+
+    start = glfwGetTimerValue();
+
+    for (i = 0;  i < iterations;  i++)
+        glfwPollEvents();
+
+    elapsed = glfwGetTimerValue() - start;
+
+    glfwDestroyWindow(window);
+    return elapsed;
+}
+
+static uint64_t run_empty_event_dispatch(int iterations)
+{
+    int i;
+    uint64_t start, elapsed;
+    GLFWwindow* window = create_window(GLFW_NO_API);
+    if (!window)
+        return 0;
+
+    // Each empty event is posted and then dispatched by the next poll
+    start = glfwGetTimerValue();
+
+    for (i = 0;  i < iterations;  i++)
+    {
+        glfwPostEmptyEvent();
+        glfwPollEvents();
+    }
+
+    elapsed = glfwGetTimerValue() - start;
+
+    glfwDestroyWindow(window);
+    return elapsed;
+}
+
+static uint64_t run_get_time(int iterations)
+{
+    int i;
+    double sum = 0.0;
+    const uint64_t start = glfwGetTimerValue();
+
+    for (i = 0;  i < iterations;  i++)
+        sum += glfwGetTime();
+
+    // Keep the compiler from discarding the calls
+    if (sum < 0.0)
+        printf("%f\n", sum);
+
+    return glfwGetTimerValue() - start;
+}
+
+static uint64_t run_get_timer_value(int iterations)
+{
+    int i;
+    uint64_t sum = 0;
+    const uint64_t start = glfwGetTimerValue();
+
+    for (i = 0;  i < iterations;  i++)
+        sum += glfwGetTimerValue();
+
+    if (sum == 0)
+        printf("%u\n", (unsigned int) sum);
+
+    return glfwGetTimerValue() - start;
+}
+
+static uint64_t run_get_monitors(int iterations)
+{
+    int i, count;
+    const uint64_t start = glfwGetTimerValue();
+
+    for (i = 0;  i < iterations;  i++)
+    {
+        GLFWmonitor** monitors = glfwGetMonitors(&count);
+
+        // The null platform has no monitors
+        if (count > 0)
+        {
+            glfwGetVideoMode(monitors[0]);
+            glfwGetVideoModes(monitors[0], &count);
+        }
+    }
+
+    return glfwGetTimerValue() - start;
+}
+
+static const Benchmark benchmarks[] =
+{
+    { "init_terminate", 50, run_init_terminate },
+    { "window_create_destroy", 100, run_window_create_destroy },
+    { "context_create_destroy", 20, run_context_create_destroy },
+    { "make_context_current", 10000, run_make_context_current },
+    { "update_gamepad_mappings", 10, run_update_gamepad_mappings },
+    { "poll_events", 10000, run_poll_events },
+    { "empty_event_dispatch", 1000, run_empty_event_dispatch },
+    { "get_time", 1000000, run_get_time },
+    { "get_timer_value", 1000000, run_get_timer_value },
+    { "get_monitors", 10000, run_get_monitors }
+};
+
+static char* join_mappings(void)
+{
+    int i;
+    size_t length = 1;
+    char* result;
+
+    for (i = 0;  default_mappings[i];  i++)
+        length += strlen(default_mappings[i]) + 1;
+
+    result = calloc(length, 1);
+
+    for (i = 0;  default_mappings[i];  i++)
+    {
+        strcat(result, default_mappings[i]);
+        strcat(result, "\n");
+    }
+
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, scale = 1, first = GLFW_TRUE, result = EXIT_SUCCESS;
+    size_t i;
+    const char* only = NULL;
+
+    while ((ch = getopt(argc, argv, "b:ehn:o")) != -1)
+    {
+        switch (ch)
+        {
+            case 'b':
+                only = optarg;
+                break;
+            case 'e':
+                api = GLFW_EGL_CONTEXT_API;
+                break;
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+            case 'n':
+                scale = atoi(optarg);
+                break;
+            case 'o':
+                api = GLFW_OSMESA_CONTEXT_API;
+                break;
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (scale < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    if (only)
+    {
+        for (i = 0;  i < sizeof(benchmarks) / sizeof(benchmarks[0]);  i++)
+        {
+            if (strcmp(only, benchmarks[i].name) == 0)
+                break;
+        }
+
+        if (i == sizeof(benchmarks) / sizeof(benchmarks[0]))
+        {
+            fprintf(stderr, "Unknown benchmark %s\n", only);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    mappings = join_mappings();
+
+    printf("{\n");
+    printf("  \"version\": \"%s\",\n", glfwGetVersionString());
+    printf("  \"benchmarks\": [");
+
+    for (i = 0;  i < sizeof(benchmarks) / sizeof(benchmarks[0]);  i++)
+    {
+        const Benchmark* benchmark = benchmarks + i;
+        const int iterations = benchmark->iterations * scale;
+        uint64_t elapsed;
+        double seconds;
+        GLFWcallcounts counts;
+
+        if (only && strcmp(only, benchmark->name) != 0)
+            continue;
+
+        glfwResetCallCounts();
+
+        elapsed = benchmark->run(iterations);
+        if (!elapsed)
+        {
+            fprintf(stderr, "Benchmark %s failed\n", benchmark->name);
+            result = EXIT_FAILURE;
+            continue;
+        }
+
+        seconds = (double) elapsed / glfwGetTimerFrequency();
+
+        printf("%s\n    {\n", first ? "" : ",");
+        printf("      \"name\": \"%s\",\n", benchmark->name);
+        printf("      \"iterations\": %i,\n", iterations);
+        printf("      \"seconds\": %0.9f,\n", seconds);
+        printf("      \"ns_per_iteration\": %0.3f", seconds * 1e9 / iterations);
+
+        // The call counts are cleared by glfwTerminate
+        if (glfwGetCallCounts(&counts) &&
+            benchmark->run != run_init_terminate)
+        {
+            printf(",\n      \"round_trips\": %u,\n",
+                   (unsigned int) counts.roundTrips);
+            printf("      \"device_reads\": %u,\n",
+                   (unsigned int) counts.deviceReads);
+            printf("      \"make_currents\": %u,\n",
+                   (unsigned int) counts.makeCurrents);
+            printf("      \"buffer_swaps\": %u,\n",
+                   (unsigned int) counts.bufferSwaps);
+            printf("      \"shm_mappings\": %u",
+                   (unsigned int) counts.shmMappings);
+        }
+
+        printf("\n    }");
+        first = GLFW_FALSE;
+    }
+
+    printf("\n  ]\n}\n");
+
+    free(mappings);
+
+    glfwTerminate();
+    exit(result);
+}
@@ -84,6 +84,7 @@ static void usage(void)
     printf("  -s, --robustness=STRATEGY the robustness strategy to use ("
                                         STRATEGY_NAME_NONE " or "
                                         STRATEGY_NAME_LOSE ")\n");
+    printf("  -t, --timings             print how long startup steps took\n");
     printf("  -v, --version             print version information\n");
     printf("      --red-bits=N          the number of red bits to request\n");
     printf("      --green-bits=N        the number of green bits to request\n");
@@ -102,6 +103,7 @@ static void usage(void)
     printf("      --singlebuffer        request single-buffering\n");
     printf("      --no-error            request a context that does not emit errors\n");
     printf("      --graphics-switching  request macOS graphics switching\n");
+    printf("      --vulkan-prefetch     look for the Vulkan loader during init\n");
 }
 
 static void error_callback(int error, const char* description)
@@ -308,6 +310,11 @@ static void print_version(void)
     printf("GLFW library version string: \"%s\"\n", glfwGetVersionString());
 }
 
+static double elapsed_ms(uint64_t start)
+{
+    return (glfwGetTimerValue() - start) * 1000.0 / glfwGetTimerFrequency();
+}
+
 static GLADapiproc glad_vulkan_callback(const char* name, void* user)
 {
     return glfwGetInstanceProcAddress((VkInstance) user, name);
@@ -316,7 +323,9 @@ static GLADapiproc glad_vulkan_callback(const char* name, void* user)
 int main(int argc, char** argv)
 {
     int ch;
-    bool list_extensions = false, list_layers = false;
+    bool list_extensions = false, list_layers = false, timings = false;
+    uint64_t start;
+    double init_ms = 0.0;
 
     enum { CLIENT, CONTEXT, BEHAVIOR, DEBUG_CONTEXT, FORWARD, HELP,
            EXTENSIONS, LAYERS,
@@ -324,7 +333,7 @@ int main(int argc, char** argv)
            REDBITS, GREENBITS, BLUEBITS, ALPHABITS, DEPTHBITS, STENCILBITS,
            ACCUMREDBITS, ACCUMGREENBITS, ACCUMBLUEBITS, ACCUMALPHABITS,
            AUXBUFFERS, SAMPLES, STEREO, SRGB, SINGLEBUFFER, NOERROR_SRSLY,
-           GRAPHICS_SWITCHING };
+           GRAPHICS_SWITCHING, TIMINGS, VULKAN_PREFETCH };
     const struct option options[] =
     {
         { "behavior",           1, NULL, BEHAVIOR },
@@ -339,6 +348,7 @@ int main(int argc, char** argv)
         { "minor",              1, NULL, MINOR },
         { "profile",            1, NULL, PROFILE },
         { "robustness",         1, NULL, ROBUSTNESS },
+        { "timings",            0, NULL, TIMINGS },
         { "version",            0, NULL, VERSION },
         { "red-bits",           1, NULL, REDBITS },
         { "green-bits",         1, NULL, GREENBITS },
@@ -357,6 +367,7 @@ int main(int argc, char** argv)
         { "singlebuffer",       0, NULL, SINGLEBUFFER },
         { "no-error",           0, NULL, NOERROR_SRSLY },
         { "graphics-switching", 0, NULL, GRAPHICS_SWITCHING },
+        { "vulkan-prefetch",    0, NULL, VULKAN_PREFETCH },
         { NULL, 0, NULL, 0 }
     };
 
@@ -369,10 +380,33 @@ int main(int argc, char** argv)
 
     glfwInitHint(GLFW_COCOA_MENUBAR, GLFW_FALSE);
 
+    // Init hints must be set before initialization, which the window hints set
+    // by the other options require
+    for (int i = 1;  i < argc;  i++)
+    {
+        if (strcmp(argv[i], "--vulkan-prefetch") == 0)
+            glfwInitHint(GLFW_VULKAN_LOADER_PREFETCH, GLFW_TRUE);
+        else if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--timings") == 0)
+            timings = true;
+    }
+
     if (!glfwInit())
         exit(EXIT_FAILURE);
 
-    while ((ch = getopt_long(argc, argv, "a:b:c:dfhlm:n:p:s:v", options, NULL)) != -1)
+    if (timings)
+    {
+        // The timer is not available before initialization, so time a second
+        // initialization instead, including the termination before it
+        start = glfwGetTimerValue();
+        glfwTerminate();
+
+        if (!glfwInit())
+            exit(EXIT_FAILURE);
+
+        init_ms = elapsed_ms(start);
+    }
+
+    while ((ch = getopt_long(argc, argv, "a:b:c:dfhlm:n:p:s:tv", options, NULL)) != -1)
     {
         switch (ch)
         {
@@ -574,6 +608,12 @@ int main(int argc, char** argv)
             case GRAPHICS_SWITCHING:
                 glfwWindowHint(GLFW_COCOA_GRAPHICS_SWITCHING, GLFW_TRUE);
                 break;
+            case 't':
+            case TIMINGS:
+                timings = true;
+                break;
+            case VULKAN_PREFETCH:
+                break;
             default:
                 usage();
                 exit(EXIT_FAILURE);
@@ -582,8 +622,13 @@ int main(int argc, char** argv)
 
     print_version();
 
+    if (timings)
+        printf("Termination and initialization: %0.3f ms\n", init_ms);
+
     glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
+    start = glfwGetTimerValue();
+
     GLFWwindow* window = glfwCreateWindow(200, 200, "Version", NULL, NULL);
     if (!window)
     {
@@ -591,6 +636,9 @@ int main(int argc, char** argv)
         exit(EXIT_FAILURE);
     }
 
+    if (timings)
+        printf("Window and context creation: %0.3f ms\n", elapsed_ms(start));
+
     glfwMakeContextCurrent(window);
     gladLoadGL(glfwGetProcAddress);
 
@@ -767,8 +815,20 @@ int main(int argc, char** argv)
     if (list_extensions)
         list_context_extensions(client, major, minor);
 
-    printf("Vulkan loader: %s\n",
-           glfwVulkanSupported() ? "available" : "missing");
+    start = glfwGetTimerValue();
+    const bool vulkan = glfwVulkanSupported();
+    const double search_ms = elapsed_ms(start);
+
+    printf("Vulkan loader: %s\n", vulkan ? "available" : "missing");
+
+    if (timings)
+    {
+        printf("Vulkan loader search: %0.3f ms\n", search_ms);
+
+        start = glfwGetTimerValue();
+        glfwVulkanSupported();
+        printf("Vulkan loader search (repeated): %0.3f ms\n", elapsed_ms(start));
+    }
 
     if (glfwVulkanSupported())
     {
@@ -849,6 +909,13 @@ int main(int argc, char** argv)
                    VK_VERSION_MAJOR(pdp.apiVersion),
                    VK_VERSION_MINOR(pdp.apiVersion));
 
+            if (re)
+            {
+                uint32_t mask;
+                glfwGetPhysicalDevicePresentationSupportMask(instance, pd[i], &mask);
+                printf("Vulkan device presentation support mask: 0x%08x\n", mask);
+            }
+
             if (list_extensions)
                 list_vulkan_device_extensions(instance, pd[i]);
 
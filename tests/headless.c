@@ -0,0 +1,230 @@
+//========================================================================
+// Headless rendering test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test creates a hidden window with a context, renders a known pattern
+// with it, reads the pixels back and checks them
+//
+// It is intended for the null platform, where -e selects a headless EGL
+// context instead of OSMesa, for example with a software renderer:
+//
+//   EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 ./headless -e
+//
+// If the context has no default framebuffer, the pattern is rendered to a
+// framebuffer object instead
+//
+// With -r, the pattern is also checked in the frame mapped by
+// glfwMapFramebuffer after the buffer swap
+//
+//========================================================================
+
+#include <glad/gl.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+#define WIDTH 64
+#define HEIGHT 48
+
+static void usage(void)
+{
+    printf("Usage: headless [-e|-o|-h] [-r]\n");
+    printf("  -e use EGL\n");
+    printf("  -o use OSMesa\n");
+    printf("  -r check glfwMapFramebuffer\n");
+    printf("  -h show this help\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static int check_pixel(const unsigned char* pixels, int stride, int x, int y,
+                       unsigned char r, unsigned char g, unsigned char b)
+{
+    const unsigned char* p = pixels + y * stride + x * 4;
+    if (p[0] != r || p[1] != g || p[2] != b)
+    {
+        fprintf(stderr, "Pixel %i,%i is %u,%u,%u, expected %u,%u,%u\n",
+                x, y, p[0], p[1], p[2], r, g, b);
+        return GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
+}
+
+static int check_pattern(const unsigned char* pixels, int stride)
+{
+    return check_pixel(pixels, stride, 0, 0, 0, 255, 0) &&
+           check_pixel(pixels, stride, WIDTH / 2 - 1, HEIGHT / 2 - 1, 0, 255, 0) &&
+           check_pixel(pixels, stride, WIDTH / 2, HEIGHT / 2, 255, 0, 0) &&
+           check_pixel(pixels, stride, WIDTH - 1, HEIGHT - 1, 255, 0, 0);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, width, height, result = EXIT_SUCCESS;
+    int api = GLFW_NATIVE_CONTEXT_API, readback = GLFW_FALSE;
+    GLuint fbo = 0, rbo = 0;
+    GLFWwindow* window;
+    unsigned char* pixels;
+
+    glfwSetErrorCallback(error_callback);
+
+    while ((ch = getopt(argc, argv, "ehor")) != -1)
+    {
+        switch (ch)
+        {
+            case 'e':
+                api = GLFW_EGL_CONTEXT_API;
+                break;
+            case 'o':
+                api = GLFW_OSMESA_CONTEXT_API;
+                break;
+            case 'r':
+                readback = GLFW_TRUE;
+                break;
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    printf("GLFW %s\n", glfwGetVersionString());
+
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, api);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    if (readback)
+        glfwWindowHint(GLFW_READBACK_BUFFERS, 2);
+
+    window = glfwCreateWindow(WIDTH, HEIGHT, "Headless", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwMakeContextCurrent(window);
+    gladLoadGL(glfwGetProcAddress);
+
+    printf("GL_RENDERER: %s\n", (const char*) glGetString(GL_RENDERER));
+
+    glfwGetFramebufferSize(window, &width, &height);
+    if (width != WIDTH || height != HEIGHT)
+    {
+        fprintf(stderr, "Framebuffer size is %ix%i, expected %ix%i\n",
+                width, height, WIDTH, HEIGHT);
+        result = EXIT_FAILURE;
+    }
+
+    if (GLAD_GL_VERSION_3_0 &&
+        glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_UNDEFINED)
+    {
+        printf("No default framebuffer, rendering to a framebuffer object\n");
+
+        glGenRenderbuffers(1, &rbo);
+        glBindRenderbuffer(GL_RENDERBUFFER, rbo);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, WIDTH, HEIGHT);
+
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                                  GL_RENDERBUFFER, rbo);
+    }
+
+    glViewport(0, 0, WIDTH, HEIGHT);
+
+    // Red background with a green lower left quadrant
+    glClearColor(1.f, 0.f, 0.f, 1.f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(0, 0, WIDTH / 2, HEIGHT / 2);
+    glClearColor(0.f, 1.f, 0.f, 1.f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glDisable(GL_SCISSOR_TEST);
+
+    pixels = calloc(WIDTH * HEIGHT, 4);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, WIDTH, HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+    if (!check_pattern(pixels, WIDTH * 4))
+        result = EXIT_FAILURE;
+
+    free(pixels);
+
+    glfwSwapBuffers(window);
+
+    if (readback)
+    {
+        GLFWframebufferdesc desc;
+
+        glFinish();
+
+        if (!glfwMapFramebuffer(window, &desc))
+        {
+            fprintf(stderr, "No frame could be mapped\n");
+            result = EXIT_FAILURE;
+        }
+        else
+        {
+            if (desc.width != WIDTH || desc.height != HEIGHT)
+            {
+                fprintf(stderr, "Mapped frame is %ix%i, expected %ix%i\n",
+                        desc.width, desc.height, WIDTH, HEIGHT);
+                result = EXIT_FAILURE;
+            }
+            else if (!check_pattern(desc.pixels, desc.stride))
+                result = EXIT_FAILURE;
+
+            glfwUnmapFramebuffer(window);
+        }
+    }
+
+    if (fbo)
+    {
+        glDeleteFramebuffers(1, &fbo);
+        glDeleteRenderbuffers(1, &rbo);
+    }
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+
+    if (result == EXIT_SUCCESS)
+        printf("Pixels read back correctly\n");
+
+    exit(result);
+}
@@ -0,0 +1,240 @@
+//========================================================================
+// XKB key name lookup test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test checks the XKB key name table used by X11 against the chain of
+// string comparisons it replaced, then measures how long each takes to map
+// a typical keymap, as done when the keyboard is changed.
+//
+// It is built directly from the library source and does not need a display.
+//
+//========================================================================
+
+#include "xkb_keys.h"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "getopt.h"
+
+// The names of a typical evdev keymap, which includes many keys that are not
+// mapped by name, in key code order starting at 8
+//
+static const char* keymapNames[] =
+{
+    "", "ESC", "AE01", "AE02", "AE03", "AE04", "AE05", "AE06", "AE07", "AE08",
+    "AE09", "AE10", "AE11", "AE12", "BKSP", "TAB", "AD01", "AD02", "AD03",
+    "AD04", "AD05", "AD06", "AD07", "AD08", "AD09", "AD10", "AD11", "AD12",
+    "RTRN", "LCTL", "AC01", "AC02", "AC03", "AC04", "AC05", "AC06", "AC07",
+    "AC08", "AC09", "AC10", "AC11", "TLDE", "LFSH", "BKSL", "AB01", "AB02",
+    "AB03", "AB04", "AB05", "AB06", "AB07", "AB08", "AB09", "AB10", "RTSH",
+    "KPMU", "LALT", "SPCE", "CAPS", "FK01", "FK02", "FK03", "FK04", "FK05",
+    "FK06", "FK07", "FK08", "FK09", "FK10", "NMLK", "SCLK", "KP7", "KP8",
+    "KP9", "KPSU", "KP4", "KP5", "KP6", "KPAD", "KP1", "KP2", "KP3", "KP0",
+    "KPDL", "LVL3", "", "LSGT", "FK11", "FK12", "AB11", "KATA", "HIRA",
+    "HENK", "HKTG", "MUHE", "JPCM", "KPEN", "RCTL", "KPDV", "PRSC", "RALT",
+    "LNFD", "HOME", "UP", "PGUP", "LEFT", "RGHT", "END", "DOWN", "PGDN",
+    "INS", "DELE", "I120", "MUTE", "VOL-", "VOL+", "POWR", "KPEQ", "I126",
+    "PAUS", "I128", "I129", "HNGL", "HJCV", "AE13", "LWIN", "RWIN", "COMP"
+};
+
+static void usage(void)
+{
+    printf("Usage: keynames [-h] [-n COUNT]\n");
+    printf("Options:\n");
+    printf("  -n COUNT  map the keymap COUNT times (default 10000)\n");
+}
+
+// The string comparisons formerly used by X11 to map key names
+//
+static int reference(const char* name)
+{
+    if (strcmp(name, "TLDE") == 0) return GLFW_KEY_GRAVE_ACCENT;
+    else if (strcmp(name, "AE01") == 0) return GLFW_KEY_1;
+    else if (strcmp(name, "AE02") == 0) return GLFW_KEY_2;
+    else if (strcmp(name, "AE03") == 0) return GLFW_KEY_3;
+    else if (strcmp(name, "AE04") == 0) return GLFW_KEY_4;
+    else if (strcmp(name, "AE05") == 0) return GLFW_KEY_5;
+    else if (strcmp(name, "AE06") == 0) return GLFW_KEY_6;
+    else if (strcmp(name, "AE07") == 0) return GLFW_KEY_7;
+    else if (strcmp(name, "AE08") == 0) return GLFW_KEY_8;
+    else if (strcmp(name, "AE09") == 0) return GLFW_KEY_9;
+    else if (strcmp(name, "AE10") == 0) return GLFW_KEY_0;
+    else if (strcmp(name, "AE11") == 0) return GLFW_KEY_MINUS;
+    else if (strcmp(name, "AE12") == 0) return GLFW_KEY_EQUAL;
+    else if (strcmp(name, "AD01") == 0) return GLFW_KEY_Q;
+    else if (strcmp(name, "AD02") == 0) return GLFW_KEY_W;
+    else if (strcmp(name, "AD03") == 0) return GLFW_KEY_E;
+    else if (strcmp(name, "AD04") == 0) return GLFW_KEY_R;
+    else if (strcmp(name, "AD05") == 0) return GLFW_KEY_T;
+    else if (strcmp(name, "AD06") == 0) return GLFW_KEY_Y;
+    else if (strcmp(name, "AD07") == 0) return GLFW_KEY_U;
+    else if (strcmp(name, "AD08") == 0) return GLFW_KEY_I;
+    else if (strcmp(name, "AD09") == 0) return GLFW_KEY_O;
+    else if (strcmp(name, "AD10") == 0) return GLFW_KEY_P;
+    else if (strcmp(name, "AD11") == 0) return GLFW_KEY_LEFT_BRACKET;
+    else if (strcmp(name, "AD12") == 0) return GLFW_KEY_RIGHT_BRACKET;
+    else if (strcmp(name, "AC01") == 0) return GLFW_KEY_A;
+    else if (strcmp(name, "AC02") == 0) return GLFW_KEY_S;
+    else if (strcmp(name, "AC03") == 0) return GLFW_KEY_D;
+    else if (strcmp(name, "AC04") == 0) return GLFW_KEY_F;
+    else if (strcmp(name, "AC05") == 0) return GLFW_KEY_G;
+    else if (strcmp(name, "AC06") == 0) return GLFW_KEY_H;
+    else if (strcmp(name, "AC07") == 0) return GLFW_KEY_J;
+    else if (strcmp(name, "AC08") == 0) return GLFW_KEY_K;
+    else if (strcmp(name, "AC09") == 0) return GLFW_KEY_L;
+    else if (strcmp(name, "AC10") == 0) return GLFW_KEY_SEMICOLON;
+    else if (strcmp(name, "AC11") == 0) return GLFW_KEY_APOSTROPHE;
+    else if (strcmp(name, "AB01") == 0) return GLFW_KEY_Z;
+    else if (strcmp(name, "AB02") == 0) return GLFW_KEY_X;
+    else if (strcmp(name, "AB03") == 0) return GLFW_KEY_C;
+    else if (strcmp(name, "AB04") == 0) return GLFW_KEY_V;
+    else if (strcmp(name, "AB05") == 0) return GLFW_KEY_B;
+    else if (strcmp(name, "AB06") == 0) return GLFW_KEY_N;
+    else if (strcmp(name, "AB07") == 0) return GLFW_KEY_M;
+    else if (strcmp(name, "AB08") == 0) return GLFW_KEY_COMMA;
+    else if (strcmp(name, "AB09") == 0) return GLFW_KEY_PERIOD;
+    else if (strcmp(name, "AB10") == 0) return GLFW_KEY_SLASH;
+    else if (strcmp(name, "BKSL") == 0) return GLFW_KEY_BACKSLASH;
+    else if (strcmp(name, "LSGT") == 0) return GLFW_KEY_WORLD_1;
+    else return GLFW_KEY_UNKNOWN;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, iterations = 10000, mapped = 0, sum = 0;
+    size_t j;
+    const size_t count = sizeof(keymapNames) / sizeof(keymapNames[0]);
+    char (*names)[4];
+    clock_t start;
+    double reference_time, table_time;
+    _GLFWxkbkeys table;
+
+    while ((ch = getopt(argc, argv, "hn:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                iterations = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (iterations < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    // XKB stores key names as four bytes padded with zeroes
+    names = calloc(count, sizeof(names[0]));
+    for (j = 0;  j < count;  j++)
+        memcpy(names[j], keymapNames[j], strlen(keymapNames[j]));
+
+    _glfwInitXkbKeys(&table);
+
+    for (j = 0;  j < count;  j++)
+    {
+        int expected, actual;
+        char name[5];
+        memcpy(name, names[j], 4);
+        name[4] = '\0';
+
+        expected = reference(name);
+        actual = _glfwGetXkbKey(&table, names[j]);
+        if (expected != actual)
+        {
+            fprintf(stderr, "Key name \"%s\" mapped to %i instead of %i\n",
+                    name, actual, expected);
+            exit(EXIT_FAILURE);
+        }
+
+        if (actual != GLFW_KEY_UNKNOWN)
+            mapped++;
+    }
+
+    if (mapped != 48)
+    {
+        fprintf(stderr, "Mapped %i key names instead of 48\n", mapped);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("Mapping a keymap of %i key codes %i times\n", (int) count, iterations);
+
+    start = clock();
+
+    for (i = 0;  i < iterations;  i++)
+    {
+        for (j = 0;  j < count;  j++)
+        {
+            char name[5];
+            memcpy(name, names[j], 4);
+            name[4] = '\0';
+
+            sum += reference(name);
+        }
+    }
+
+    reference_time = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+
+    // The table is filled each time, as it is when the keymap changes
+    for (i = 0;  i < iterations;  i++)
+    {
+        _glfwInitXkbKeys(&table);
+
+        for (j = 0;  j < count;  j++)
+            sum -= _glfwGetXkbKey(&table, names[j]);
+    }
+
+    table_time = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    // Use the results so the loops are not optimized away
+    if (sum != 0)
+    {
+        fprintf(stderr, "Keymap results differ\n");
+        exit(EXIT_FAILURE);
+    }
+
+    printf("strcmp chain: %10.3f us per keymap\n", reference_time * 1e6 / iterations);
+    printf("hash table:   %10.3f us per keymap (%0.1fx)\n",
+           table_time * 1e6 / iterations, reference_time / table_time);
+
+    free(names);
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,232 @@
+//========================================================================
+// Pixel conversion test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test checks the pixel conversion used for X11 and Wayland cursors
+// and icons against the per-pixel loops it replaced, then measures its
+// throughput against those loops.
+//
+// It is built directly from the library source and does not need a display.
+//
+//========================================================================
+
+#include "pixels.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "getopt.h"
+
+static void usage(void)
+{
+    printf("Usage: pixels [-h] [-s SIZE] [-n COUNT]\n");
+    printf("Options:\n");
+    printf("  -s SIZE   benchmark images of SIZE by SIZE pixels (default 64)\n");
+    printf("  -n COUNT  convert each benchmark image COUNT times (default 10000)\n");
+}
+
+// The premultiplying loop formerly used for X11 and Wayland cursors
+//
+static void premultiply_reference(uint32_t* target,
+                                  const unsigned char* source,
+                                  size_t count)
+{
+    size_t i;
+
+    for (i = 0;  i < count;  i++, target++, source += 4)
+    {
+        unsigned int alpha = source[3];
+
+        *target = (alpha << 24) |
+                  ((unsigned char) ((source[0] * alpha) / 255) << 16) |
+                  ((unsigned char) ((source[1] * alpha) / 255) <<  8) |
+                  ((unsigned char) ((source[2] * alpha) / 255) <<  0);
+    }
+}
+
+// The straight loop formerly used for X11 window icons
+//
+static void convert_reference(uint32_t* target,
+                              const unsigned char* source,
+                              size_t count)
+{
+    size_t i;
+
+    for (i = 0;  i < count;  i++)
+    {
+        target[i] = ((uint32_t) source[i * 4 + 0] << 16) |
+                    ((uint32_t) source[i * 4 + 1] <<  8) |
+                    ((uint32_t) source[i * 4 + 2] <<  0) |
+                    ((uint32_t) source[i * 4 + 3] << 24);
+    }
+}
+
+typedef void (* convertfun)(uint32_t*, const unsigned char*, size_t);
+
+static int compare(const char* name,
+                   convertfun reference, convertfun convert,
+                   const unsigned char* source, size_t count,
+                   uint32_t* expected, uint32_t* actual)
+{
+    size_t i;
+
+    reference(expected, source, count);
+    convert(actual, source, count);
+
+    for (i = 0;  i < count;  i++)
+    {
+        if (expected[i] != actual[i])
+        {
+            fprintf(stderr, "%s: pixel %lu of %lu is 0x%08x instead of 0x%08x\n",
+                    name, (unsigned long) i, (unsigned long) count,
+                    actual[i], expected[i]);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static double benchmark(convertfun convert,
+                        const unsigned char* source, size_t count,
+                        uint32_t* target, int iterations)
+{
+    const clock_t start = clock();
+    int i;
+
+    for (i = 0;  i < iterations;  i++)
+        convert(target, source, count);
+
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, size = 64, iterations = 10000;
+    size_t i, count;
+    unsigned char* source;
+    uint32_t* expected;
+    uint32_t* actual;
+    double reference_time, convert_time;
+
+    while ((ch = getopt(argc, argv, "hn:s:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                iterations = atoi(optarg);
+                break;
+
+            case 's':
+                size = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (size < 1 || iterations < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    // Every color and alpha combination, plus room for the benchmark image
+    count = 65536;
+    if ((size_t) size * size > count)
+        count = (size_t) size * size;
+
+    source = malloc(count * 4 + 1);
+    expected = malloc(count * sizeof(uint32_t));
+    actual = malloc(count * sizeof(uint32_t));
+
+    for (i = 0;  i < 65536;  i++)
+    {
+        source[i * 4 + 0] = (unsigned char) (i & 255);
+        source[i * 4 + 1] = (unsigned char) (255 - (i & 255));
+        source[i * 4 + 2] = (unsigned char) ((i * 7) & 255);
+        source[i * 4 + 3] = (unsigned char) (i >> 8);
+    }
+
+    for (i = 65536;  i < count;  i++)
+    {
+        source[i * 4 + 0] = (unsigned char) rand();
+        source[i * 4 + 1] = (unsigned char) rand();
+        source[i * 4 + 2] = (unsigned char) rand();
+        source[i * 4 + 3] = (unsigned char) rand();
+    }
+
+    if (!compare("premultiply", premultiply_reference, _glfwPremultiplyPixelsARGB,
+                 source, 65536, expected, actual) ||
+        !compare("convert", convert_reference, _glfwConvertPixelsARGB,
+                 source, 65536, expected, actual))
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    // Odd counts and offsets exercise the unaligned heads and scalar tails
+    for (i = 0;  i < 67;  i++)
+    {
+        if (!compare("premultiply", premultiply_reference, _glfwPremultiplyPixelsARGB,
+                     source + 4 * (i & 3) + 1, i, expected, actual) ||
+            !compare("convert", convert_reference, _glfwConvertPixelsARGB,
+                     source + 4 * (i & 3) + 1, i, expected, actual))
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    printf("All conversions match the reference loops\n");
+
+    count = (size_t) size * size;
+
+    reference_time = benchmark(premultiply_reference, source, count, expected, iterations);
+    convert_time = benchmark(_glfwPremultiplyPixelsARGB, source, count, actual, iterations);
+
+    printf("Premultiply %ix%i: reference %0.1f Mpx/s, converter %0.1f Mpx/s\n",
+           size, size,
+           count * iterations / reference_time / 1e6,
+           count * iterations / convert_time / 1e6);
+
+    reference_time = benchmark(convert_reference, source, count, expected, iterations);
+    convert_time = benchmark(_glfwConvertPixelsARGB, source, count, actual, iterations);
+
+    printf("Convert %ix%i: reference %0.1f Mpx/s, converter %0.1f Mpx/s\n",
+           size, size,
+           count * iterations / reference_time / 1e6,
+           count * iterations / convert_time / 1e6);
+
+    free(source);
+    free(expected);
+    free(actual);
+    exit(EXIT_SUCCESS);
+}
+
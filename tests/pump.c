@@ -0,0 +1,310 @@
+//========================================================================
+// Event pump throughput and latency test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test measures the cost of the event pump, first by posting a batch of
+// empty events and timing how long glfwPollEvents takes to dispatch them,
+// then by posting single empty events from a secondary thread and timing how
+// long glfwWaitEvents takes to return
+//
+// On X11 each empty event is a client message sent through the server, so
+// this measures the complete Xlib path from the socket to the dispatcher
+//
+// On X11 it also times the dispatch of synthetic key and motion streams, as
+// from a fast typist or a high rate mouse
+//
+// With -t, a trace of the run is written in the JSON trace event format
+//
+//========================================================================
+
+#include "tinycthread.h"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#if defined(GLFW_EXPOSE_NATIVE_X11)
+ #include <GLFW/glfw3native.h>
+ #include <X11/keysym.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static mtx_t lock;
+static uint64_t posted;
+static int count;
+static int chars;
+
+static void usage(void)
+{
+    printf("Usage: pump [-n EVENTS] [-w WAKEUPS] [-t TRACEFILE]\n");
+    printf("       pump -h\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static void char_callback(GLFWwindow* window, unsigned int codepoint)
+{
+    chars++;
+}
+
+static double to_microseconds(uint64_t ticks)
+{
+    return ticks * 1e6 / glfwGetTimerFrequency();
+}
+
+static void report(const char* name, int events, uint64_t elapsed)
+{
+    printf("%s: %i events in %0.3f ms (%0.3f us/event)\n",
+           name, events, to_microseconds(elapsed) / 1e3,
+           to_microseconds(elapsed) / events);
+}
+
+static int thread_main(void* data)
+{
+    int i;
+    const int wakeups = *(int*) data;
+
+    for (i = 0;  i < wakeups;  i++)
+    {
+        struct timespec time = { 0, 1000000 };
+
+        // Give the main thread time to start waiting
+        thrd_sleep(&time, NULL);
+
+        mtx_lock(&lock);
+        posted = glfwGetTimerValue();
+        count++;
+        mtx_unlock(&lock);
+
+        glfwPostEmptyEvent();
+    }
+
+    return 0;
+}
+
+static void benchmark_poll(int events)
+{
+    int i;
+    uint64_t start, elapsed;
+
+    // The events are posted before the clock starts so only dispatch is timed
+    for (i = 0;  i < events;  i++)
+        glfwPostEmptyEvent();
+
+    start = glfwGetTimerValue();
+    glfwPollEvents();
+    elapsed = glfwGetTimerValue() - start;
+
+    report("empty events", events, elapsed);
+}
+
+#if defined(GLFW_EXPOSE_NATIVE_X11)
+static void benchmark_stream(GLFWwindow* window, int type, int events)
+{
+    int i;
+    uint64_t start, elapsed;
+    XEvent event = { 0 };
+    Display* display = glfwGetX11Display();
+    const Window handle = glfwGetX11Window(window);
+
+    for (i = 0;  i < events;  i++)
+    {
+        if (type == KeyPress)
+        {
+            // Alternate presses and releases of the A key
+            event.type = (i & 1) ? KeyRelease : KeyPress;
+            event.xkey.window = handle;
+            event.xkey.root = DefaultRootWindow(display);
+            event.xkey.same_screen = True;
+            event.xkey.keycode = XKeysymToKeycode(display, XK_a);
+        }
+        else
+        {
+            event.type = MotionNotify;
+            event.xmotion.window = handle;
+            event.xmotion.root = DefaultRootWindow(display);
+            event.xmotion.same_screen = True;
+            event.xmotion.x = i % 64;
+            event.xmotion.y = i % 64;
+        }
+
+        // With an empty event mask the event is sent to the window's creator
+        XSendEvent(display, handle, False, 0, &event);
+    }
+
+    // The events have all been queued once the reply arrives, so only their
+    // dispatch is timed
+    XSync(display, False);
+
+    chars = 0;
+
+    start = glfwGetTimerValue();
+    glfwPollEvents();
+    elapsed = glfwGetTimerValue() - start;
+
+    if (type == KeyPress)
+    {
+        report("key events", events, elapsed);
+        printf("  %i characters\n", chars);
+    }
+    else
+        report("motion events", events, elapsed);
+}
+#endif
+
+static int benchmark_wait(int wakeups)
+{
+    int i;
+    thrd_t thread;
+    uint64_t total = 0, fastest = UINT64_MAX, slowest = 0;
+
+    if (thrd_create(&thread, thread_main, &wakeups) != thrd_success)
+    {
+        fprintf(stderr, "Failed to create secondary thread\n");
+        return GLFW_FALSE;
+    }
+
+    for (i = 0;  i < wakeups;  i++)
+    {
+        uint64_t latency;
+
+        // Keep waiting until this wakeup has been posted, as the wait may
+        // also end for other events
+        for (;;)
+        {
+            glfwWaitEvents();
+
+            mtx_lock(&lock);
+            if (count > i)
+            {
+                latency = glfwGetTimerValue() - posted;
+                mtx_unlock(&lock);
+                break;
+            }
+            mtx_unlock(&lock);
+        }
+
+        total += latency;
+        if (latency < fastest)
+            fastest = latency;
+        if (latency > slowest)
+            slowest = latency;
+    }
+
+    thrd_join(thread, NULL);
+
+    printf("glfwWaitEvents: %i wakeups, latency %0.1f us min %0.1f us avg %0.1f us max\n",
+           wakeups, to_microseconds(fastest),
+           to_microseconds(total) / wakeups, to_microseconds(slowest));
+
+    return GLFW_TRUE;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, events = 10000, wakeups = 1000, result = EXIT_SUCCESS;
+    const char* trace = NULL;
+    GLFWwindow* window;
+
+    while ((ch = getopt(argc, argv, "hn:t:w:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+            case 'n':
+                events = atoi(optarg);
+                break;
+            case 't':
+                trace = optarg;
+                break;
+            case 'w':
+                wakeups = atoi(optarg);
+                break;
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (events < 1 || wakeups < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    if (trace && !glfwStartTracing(trace))
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    window = glfwCreateWindow(64, 64, "Event Pump Test", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    if (mtx_init(&lock, mtx_plain) != thrd_success)
+    {
+        fprintf(stderr, "Failed to create mutex\n");
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    // Drain any events from window creation
+    glfwPollEvents();
+
+    glfwSetCharCallback(window, char_callback);
+
+    benchmark_poll(events);
+#if defined(GLFW_EXPOSE_NATIVE_X11)
+    benchmark_stream(window, KeyPress, events);
+    benchmark_stream(window, MotionNotify, events);
+#endif
+
+    if (!benchmark_wait(wakeups))
+        result = EXIT_FAILURE;
+
+    mtx_destroy(&lock);
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    exit(result);
+}
@@ -0,0 +1,250 @@
+//========================================================================
+// Window query round-trip test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test calls each of the window state queries repeatedly and reports
+// the time per call
+//
+// It then does the same for event polling with the cursor disabled, as in
+// a first-person game
+//
+// On X11 it also counts the requests sent to the server and the calls that
+// waited for a reply, and fails if any query caused a round-trip
+//
+// If GLFW was built with call counting, the round-trips it counted are listed
+// as well
+//
+//========================================================================
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#if defined(GLFW_EXPOSE_NATIVE_X11)
+ #include <GLFW/glfw3native.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+typedef struct
+{
+    const char* name;
+    void (*query)(GLFWwindow* window);
+} Query;
+
+static void query_pos(GLFWwindow* window)
+{
+    int xpos, ypos;
+    glfwGetWindowPos(window, &xpos, &ypos);
+}
+
+static void query_size(GLFWwindow* window)
+{
+    int width, height;
+    glfwGetWindowSize(window, &width, &height);
+}
+
+static void query_framebuffer_size(GLFWwindow* window)
+{
+    int width, height;
+    glfwGetFramebufferSize(window, &width, &height);
+}
+
+static void query_cursor_pos(GLFWwindow* window)
+{
+    double xpos, ypos;
+    glfwGetCursorPos(window, &xpos, &ypos);
+}
+
+static void query_focused(GLFWwindow* window)
+{
+    glfwGetWindowAttrib(window, GLFW_FOCUSED);
+}
+
+static void query_hovered(GLFWwindow* window)
+{
+    glfwGetWindowAttrib(window, GLFW_HOVERED);
+}
+
+static void query_visible(GLFWwindow* window)
+{
+    glfwGetWindowAttrib(window, GLFW_VISIBLE);
+}
+
+static void query_iconified(GLFWwindow* window)
+{
+    glfwGetWindowAttrib(window, GLFW_ICONIFIED);
+}
+
+static void query_maximized(GLFWwindow* window)
+{
+    glfwGetWindowAttrib(window, GLFW_MAXIMIZED);
+}
+
+static void query_poll(GLFWwindow* window)
+{
+    glfwPollEvents();
+}
+
+static const Query queries[] =
+{
+    { "glfwGetWindowPos", query_pos },
+    { "glfwGetWindowSize", query_size },
+    { "glfwGetFramebufferSize", query_framebuffer_size },
+    { "glfwGetCursorPos", query_cursor_pos },
+    { "GLFW_FOCUSED", query_focused },
+    { "GLFW_HOVERED", query_hovered },
+    { "GLFW_VISIBLE", query_visible },
+    { "GLFW_ICONIFIED", query_iconified },
+    { "GLFW_MAXIMIZED", query_maximized }
+};
+
+static const Query poll = { "glfwPollEvents", query_poll };
+
+static void usage(void)
+{
+    printf("Usage: roundtrip [-n CALLS]\n");
+    printf("       roundtrip -h\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static int run_query(GLFWwindow* window, const Query* query, int calls)
+{
+    int i, requests = 0, roundtrips = 0;
+    double start, elapsed;
+    GLFWcallcounts counts;
+#if defined(GLFW_EXPOSE_NATIVE_X11)
+    Display* display = glfwGetX11Display();
+#endif
+
+    glfwResetCallCounts();
+    start = glfwGetTime();
+
+    for (i = 0;  i < calls;  i++)
+    {
+#if defined(GLFW_EXPOSE_NATIVE_X11)
+        const unsigned long first = NextRequest(display);
+
+        query->query(window);
+
+        if (NextRequest(display) != first)
+        {
+            requests += (int) (NextRequest(display) - first);
+
+            // Xlib only knows a request has been processed once it has seen
+            // a reply, event or error with a later sequence number
+            if (LastKnownRequestProcessed(display) >= first)
+                roundtrips++;
+        }
+#else
+        query->query(window);
+#endif
+    }
+
+    elapsed = glfwGetTime() - start;
+
+    printf("%-24s %10.3f us/call %8i requests %8i round-trips",
+           query->name, elapsed * 1e6 / calls, requests, roundtrips);
+
+    if (glfwGetCallCounts(&counts))
+        printf(" (%i counted by GLFW)", (int) counts.roundTrips);
+
+    printf("\n");
+
+    return roundtrips == 0;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, calls = 1000, result = EXIT_SUCCESS;
+    size_t i;
+    double start;
+    GLFWwindow* window;
+
+    while ((ch = getopt(argc, argv, "hn:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+            case 'n':
+                calls = atoi(optarg);
+                break;
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (calls < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+
+    window = glfwCreateWindow(640, 480, "Round-trip Test", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    // Let the window manager finish placing and focusing the window
+    start = glfwGetTime();
+    while (glfwGetTime() - start < 0.5)
+        glfwWaitEventsTimeout(0.1);
+
+    printf("Calling each query %i times\n", calls);
+
+    for (i = 0;  i < sizeof(queries) / sizeof(queries[0]);  i++)
+    {
+        if (!run_query(window, queries + i, calls))
+            result = EXIT_FAILURE;
+    }
+
+    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    if (glfwGetInputMode(window, GLFW_CURSOR) == GLFW_CURSOR_DISABLED)
+        printf("Polling with the cursor disabled\n");
+
+    if (!run_query(window, &poll, calls))
+        result = EXIT_FAILURE;
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    exit(result);
+}
@@ -26,6 +26,14 @@
 // This test renders a high contrast, horizontally moving bar, allowing for
 // visual verification of whether the set swap interval is indeed obeyed
 //
+// It also collects a histogram of how far each frame was presented from the
+// vertical blank grid, which is printed with H and on exit, and can wait for
+// the next vertical blank before rendering each frame, toggled with W
+//
+// If the context supports late swap tearing, T toggles between a positive and
+// negative swap interval.  L makes every fourth frame late, and the number of
+// frames that were held back an extra refresh is reported with the histogram
+//
 //========================================================================
 
 #include <glad/gl.h>
@@ -34,6 +42,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include "linmath.h"
@@ -65,17 +74,110 @@ static const char* fragment_shader_text =
 "    gl_FragColor = vec4(1.0);\n"
 "}\n";
 
+#define JITTER_BIN_COUNT 16
+#define JITTER_BIN_WIDTH 0.25
+
 static int swap_tear;
 static int swap_interval;
 static double frame_rate;
+static int wait_for_frame;
+static int late_frames;
+
+static uint64_t last_present;
+static int present_exact;
+static double refresh_ms;
+static unsigned long jitter_bins[JITTER_BIN_COUNT + 2];
+static unsigned long jitter_count;
+static unsigned long held_count;
+
+static void reset_jitter(void)
+{
+    memset(jitter_bins, 0, sizeof(jitter_bins));
+    jitter_count = 0;
+    held_count = 0;
+    last_present = 0;
+}
+
+static void record_frame_timing(GLFWwindow* window)
+{
+    GLFWframetiming timing;
+    int bin, refreshes;
+    double interval_ms, jitter_ms;
+    const double ticks_per_ms = glfwGetTimerFrequency() / 1000.0;
+
+    if (!glfwGetFrameTiming(window, &timing) || timing.present == last_present)
+        return;
+
+    if (last_present)
+    {
+        // Distance from the nearest multiple of the refresh period
+        refresh_ms = timing.refresh / ticks_per_ms;
+        interval_ms = (timing.present - last_present) / ticks_per_ms;
+        refreshes = (int) floor(interval_ms / refresh_ms + 0.5);
+        jitter_ms = interval_ms - refresh_ms * refreshes;
+
+        if (swap_interval && refreshes > abs(swap_interval))
+            held_count++;
+
+        bin = (int) floor(jitter_ms / JITTER_BIN_WIDTH) + JITTER_BIN_COUNT / 2;
+        if (bin < 0)
+            bin = -1;
+        else if (bin >= JITTER_BIN_COUNT)
+            bin = JITTER_BIN_COUNT;
+
+        jitter_bins[bin + 1]++;
+        jitter_count++;
+    }
+
+    last_present = timing.present;
+    present_exact = timing.exact;
+}
+
+static void print_jitter(void)
+{
+    int i;
+    unsigned long max = 1;
+
+    printf("Present jitter for interval %i over %lu frames, %s, refresh %0.3f ms:\n",
+           swap_interval, jitter_count,
+           present_exact ? "reported" : "estimated", refresh_ms);
+    printf("%lu frames were held back at least one extra refresh\n", held_count);
+
+    if (!jitter_count)
+        return;
+
+    for (i = 0;  i < JITTER_BIN_COUNT + 2;  i++)
+    {
+        if (jitter_bins[i] > max)
+            max = jitter_bins[i];
+    }
+
+    for (i = 0;  i < JITTER_BIN_COUNT + 2;  i++)
+    {
+        const int length = (int) (jitter_bins[i] * 50 / max);
+        const double start = (i - 1 - JITTER_BIN_COUNT / 2) * JITTER_BIN_WIDTH;
+
+        if (i == 0)
+            printf("       < %+0.2f ms ", start + JITTER_BIN_WIDTH);
+        else if (i == JITTER_BIN_COUNT + 1)
+            printf("      >= %+0.2f ms ", start);
+        else
+            printf("%+0.2f..%+0.2f ms ", start, start + JITTER_BIN_WIDTH);
+
+        printf("%8lu %.*s\n", jitter_bins[i], length,
+               "##################################################");
+    }
+}
 
 static void update_window_title(GLFWwindow* window)
 {
     char title[256];
 
-    snprintf(title, sizeof(title), "Tearing detector (interval %i%s, %0.1f Hz)",
+    snprintf(title, sizeof(title), "Tearing detector (interval %i%s%s%s, %0.1f Hz)",
              swap_interval,
              (swap_tear && swap_interval < 0) ? " (swap tear)" : "",
+             wait_for_frame ? " (wait)" : "",
+             late_frames ? " (late)" : "",
              frame_rate);
 
     glfwSetWindowTitle(window, title);
@@ -83,6 +185,11 @@ static void update_window_title(GLFWwindow* window)
 
 static void set_swap_interval(GLFWwindow* window, int interval)
 {
+    if (jitter_count)
+        print_jitter();
+
+    reset_jitter();
+
     swap_interval = interval;
     glfwSwapInterval(swap_interval);
     update_window_title(window);
@@ -122,6 +229,27 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
             break;
         }
 
+        case GLFW_KEY_H:
+            print_jitter();
+            break;
+
+        case GLFW_KEY_W:
+            wait_for_frame = !wait_for_frame;
+            reset_jitter();
+            update_window_title(window);
+            break;
+
+        case GLFW_KEY_T:
+            if (swap_tear && swap_interval)
+                set_swap_interval(window, -swap_interval);
+            break;
+
+        case GLFW_KEY_L:
+            late_frames = !late_frames;
+            reset_jitter();
+            update_window_title(window);
+            break;
+
         case GLFW_KEY_ESCAPE:
             glfwSetWindowShouldClose(window, 1);
             break;
@@ -181,8 +309,7 @@ int main(int argc, char** argv)
 
     last_time = glfwGetTime();
     frame_rate = 0.0;
-    swap_tear = (glfwExtensionSupported("WGL_EXT_swap_control_tear") ||
-                 glfwExtensionSupported("GLX_EXT_swap_control_tear"));
+    swap_tear = glfwGetWindowAttrib(window, GLFW_CONTEXT_SWAP_TEAR);
 
     glfwSetKeyCallback(window, key_callback);
 
@@ -214,7 +341,12 @@ int main(int argc, char** argv)
     {
         int width, height;
         mat4x4 m, p, mvp;
-        float position = cosf((float) glfwGetTime() * 4.f) * 0.75f;
+        float position;
+
+        if (wait_for_frame)
+            glfwWaitForNextFrame(window);
+
+        position = cosf((float) glfwGetTime() * 4.f) * 0.75f;
 
         glfwGetFramebufferSize(window, &width, &height);
 
@@ -229,9 +361,23 @@ int main(int argc, char** argv)
         glUniformMatrix4fv(mvp_location, 1, GL_FALSE, (const GLfloat*) mvp);
         glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 
+        if (late_frames && frame_count % 4 == 3)
+        {
+            // Miss the next vertical blank by a quarter of a refresh
+            const double delay = (refresh_ms > 0.0 ? refresh_ms : 1000.0 / 60.0) *
+                                 1.25 * abs(swap_interval) / 1000.0;
+            const double start = glfwGetTime();
+
+            glFinish();
+            while (glfwGetTime() - start < delay)
+                ;
+        }
+
         glfwSwapBuffers(window);
         glfwPollEvents();
 
+        record_frame_timing(window);
+
         frame_count++;
 
         current_time = glfwGetTime();
@@ -244,6 +390,8 @@ int main(int argc, char** argv)
         }
     }
 
+    print_jitter();
+
     glfwTerminate();
     exit(EXIT_SUCCESS);
 }
@@ -59,6 +59,45 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
         glfwSetWindowShouldClose(window, GLFW_TRUE);
 }
 
+// Measures the cost of querying the current context, which wrapper layers may
+// do many times per frame
+//
+static void benchmark_current_context(const Thread* thread)
+{
+    int i;
+    const int count = 10000000;
+    const double start = glfwGetTime();
+
+    for (i = 0;  i < count;  i++)
+    {
+        if (glfwGetCurrentContext() != thread->window)
+        {
+            fprintf(stderr, "%s thread has the wrong current context\n",
+                    thread->title);
+            return;
+        }
+    }
+
+    printf("%s thread: glfwGetCurrentContext takes %0.2f ns\n",
+           thread->title, (glfwGetTime() - start) * 1e9 / count);
+}
+
+// Measures the cost of defensively rebinding the context that is already
+// current, which should not reach the driver
+//
+static void benchmark_rebind_context(const Thread* thread)
+{
+    int i;
+    const int count = 1000000;
+    const double start = glfwGetTime();
+
+    for (i = 0;  i < count;  i++)
+        glfwMakeContextCurrent(thread->window);
+
+    printf("%s thread: rebinding the current context takes %0.2f ns\n",
+           thread->title, (glfwGetTime() - start) * 1e9 / count);
+}
+
 static int thread_main(void* data)
 {
     const Thread* thread = data;
@@ -66,6 +105,9 @@ static int thread_main(void* data)
     glfwMakeContextCurrent(thread->window);
     glfwSwapInterval(1);
 
+    benchmark_current_context(thread);
+    benchmark_rebind_context(thread);
+
     while (running)
     {
         const float v = (float) fabs(sin(glfwGetTime() * 2.f));
@@ -0,0 +1,245 @@
+//========================================================================
+// Background texture upload throughput test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test creates a shared context pool for a hidden window and streams
+// textures from an increasing number of worker threads, each holding a
+// context from the pool, and reports the upload throughput for each count
+//
+// On the null platform, -e selects a headless EGL context
+//
+//========================================================================
+
+#include "tinycthread.h"
+
+#include <glad/gl.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "getopt.h"
+
+typedef struct
+{
+    GLFWcontextpool* pool;
+    thrd_t id;
+    int uploads;
+    int size;
+    unsigned char* pixels;
+    GLuint texture;
+    int result;
+} Worker;
+
+static void usage(void)
+{
+    printf("Usage: upload [-e] [-t THREADS] [-n UPLOADS] [-s SIZE]\n");
+    printf("       upload -h\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static int worker_main(void* data)
+{
+    int i;
+    Worker* worker = data;
+
+    if (!glfwAcquireSharedContext(worker->pool))
+    {
+        worker->result = GLFW_FALSE;
+        return 0;
+    }
+
+    glGenTextures(1, &worker->texture);
+    glBindTexture(GL_TEXTURE_2D, worker->texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, worker->size, worker->size, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+    for (i = 0;  i < worker->uploads;  i++)
+    {
+        // Touch the data so every upload carries a distinct image
+        worker->pixels[0] = (unsigned char) i;
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, worker->size, worker->size,
+                        GL_RGBA, GL_UNSIGNED_BYTE, worker->pixels);
+    }
+
+    // The texture is only usable by other contexts once the upload completes
+    glFinish();
+
+    glfwReleaseSharedContext(worker->pool);
+    worker->result = GLFW_TRUE;
+    return 0;
+}
+
+static int benchmark(GLFWcontextpool* pool, Worker* workers, int count,
+                     int uploads, int size)
+{
+    int i, result = GLFW_TRUE;
+    double start, elapsed, megabytes;
+
+    start = glfwGetTime();
+
+    for (i = 0;  i < count;  i++)
+    {
+        workers[i].pool = pool;
+        workers[i].uploads = uploads;
+        workers[i].size = size;
+        workers[i].texture = 0;
+
+        if (thrd_create(&workers[i].id, worker_main, workers + i) !=
+            thrd_success)
+        {
+            fprintf(stderr, "Failed to create worker thread\n");
+            count = i;
+            result = GLFW_FALSE;
+            break;
+        }
+    }
+
+    for (i = 0;  i < count;  i++)
+    {
+        thrd_join(workers[i].id, NULL);
+        if (!workers[i].result)
+            result = GLFW_FALSE;
+    }
+
+    elapsed = glfwGetTime() - start;
+    megabytes = (double) size * size * 4 * uploads * count / 1e6;
+
+    printf("%i thread(s): %i uploads in %0.3f s (%0.1f MB/s)\n",
+           count, uploads * count, elapsed, megabytes / elapsed);
+
+    // The textures are shared with the window context
+    for (i = 0;  i < count;  i++)
+    {
+        if (workers[i].texture)
+        {
+            if (!glIsTexture(workers[i].texture))
+            {
+                fprintf(stderr, "Texture %u is not visible to the window\n",
+                        workers[i].texture);
+                result = GLFW_FALSE;
+            }
+
+            glDeleteTextures(1, &workers[i].texture);
+        }
+    }
+
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    int i, ch, threads = 4, uploads = 64, size = 1024;
+    int api = GLFW_NATIVE_CONTEXT_API, result = EXIT_SUCCESS;
+    GLFWwindow* window;
+    GLFWcontextpool* pool;
+    Worker* workers;
+
+    while ((ch = getopt(argc, argv, "ehn:s:t:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'e':
+                api = GLFW_EGL_CONTEXT_API;
+                break;
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+            case 'n':
+                uploads = atoi(optarg);
+                break;
+            case 's':
+                size = atoi(optarg);
+                break;
+            case 't':
+                threads = atoi(optarg);
+                break;
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (threads < 1 || uploads < 1 || size < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, api);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    window = glfwCreateWindow(64, 64, "Upload", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwMakeContextCurrent(window);
+    gladLoadGL(glfwGetProcAddress);
+
+    pool = glfwCreateSharedContextPool(window, threads);
+    if (!pool)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    printf("Uploading %i %ix%i textures per thread\n", uploads, size, size);
+
+    workers = calloc(threads, sizeof(Worker));
+    for (i = 0;  i < threads;  i++)
+    {
+        workers[i].pixels = malloc((size_t) size * size * 4);
+        memset(workers[i].pixels, i * 32, (size_t) size * size * 4);
+    }
+
+    for (i = 1;  i <= threads;  i++)
+    {
+        if (!benchmark(pool, workers, i, uploads, size))
+            result = EXIT_FAILURE;
+    }
+
+    for (i = 0;  i < threads;  i++)
+        free(workers[i].pixels);
+    free(workers);
+
+    glfwDestroySharedContextPool(pool);
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    exit(result);
+}